@@ -1437,6 +1437,32 @@ mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_set_rnn_weights_qparams (
         mkldnn_primitive_attr_t attr, mkldnn_dim_t count, int mask,
                 const float *weights_scales);
 
+/// Sets the data type @p data_type in which the RNN workspace keeps the
+/// gates and states passed from forward training to backward propagation.
+/// Only #mkldnn_f32 (default) and #mkldnn_f16 are supported.
+///
+/// With #mkldnn_f16 the workspace takes half the memory. The primitives still
+/// compute and accumulate in f32, on copies of the gates and states kept in
+/// the scratchpad for the duration of the execution, so the backward pass
+/// sees the forward values rounded to f16.
+/// @note
+///     The same data type must be set on the attributes of the forward
+///     training and of the backward primitive descriptors.
+mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_set_rnn_workspace_data_type(
+        mkldnn_primitive_attr_t attr, mkldnn_data_type_t data_type);
+
+/// Sets the checkpoint @p interval of the RNN training workspace. With a
+/// nonzero @p interval, forward training stores no gates in the workspace
+/// and keeps the LSTM cell states only for every @p interval-th iteration.
+/// The hidden states are all kept. Backward recomputes the gates and cell
+/// states, @p interval iterations at a time. This trades one extra forward
+/// pass for most of the workspace memory. The default 0 stores everything.
+/// @note
+///     The same interval must be set on the attributes of the forward
+///     training and of the backward primitive descriptors.
+mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_set_rnn_workspace_checkpoint(
+        mkldnn_primitive_attr_t attr, int interval);
+
 /// Initializes a rnn descriptor @p rnn_desc for forward propagation
 /// using @p prop_kind, @p rnn_cell_desc, @p direction, and memory descriptors.
 /// @note If @p prop_kind equals #mkldnn_forward_training, you must query a
@@ -1473,6 +1499,60 @@ mkldnn_status_t MKLDNN_API mkldnn_rnn_forward_desc_init(
         const mkldnn_memory_desc_t *dst_layer_desc,
         const mkldnn_memory_desc_t *dst_iter_desc);
 
+/// Initializes a rnn descriptor @p rnn_desc for forward propagation of an
+/// LSTM cell with optional peephole connections and recurrent projection
+/// using @p prop_kind, @p rnn_cell_desc, @p direction, and memory descriptors.
+/// The cell kind must be #mkldnn_vanilla_lstm.
+///
+/// @p weights_peephole_desc, of dimensions (num_layers, num_directions, 3,
+/// num_channels_in_hidden_state), holds the weights applied to the cell state
+/// by the input, forget and output gates, in that order. @p
+/// weights_projection_desc, of dimensions (num_layers, num_directions,
+/// num_channels_in_hidden_state, num_channels_in_recurrent_projection),
+/// holds the weights the hidden state is multiplied by before it is passed
+/// to the next layer and iteration. The projection keeps the size of the
+/// state, since the hidden and cell states share the src_iter and dst_iter
+/// tensors.
+///
+/// Both are allowed to either be @c NULL or point to a zero memory
+/// descriptor, in which case this function is equivalent to
+/// mkldnn_rnn_forward_desc_init(). They are allowed to be initialized with
+/// #mkldnn_format_kind_any value of @p format_kind.
+///
+/// Inputs, in addition to those of mkldnn_rnn_forward_desc_init():
+///  - weights_peephole (#mkldnn_query_weights_md, 3), if used
+///  - weights_projection (#mkldnn_query_weights_md, 4), if used
+mkldnn_status_t MKLDNN_API mkldnn_lstm_forward_desc_init(
+        mkldnn_rnn_desc_t *rnn_desc, mkldnn_prop_kind_t prop_kind,
+        const mkldnn_rnn_cell_desc_t *rnn_cell_desc,
+        const mkldnn_rnn_direction_t direction,
+        const mkldnn_memory_desc_t *src_layer_desc,
+        const mkldnn_memory_desc_t *src_iter_desc,
+        const mkldnn_memory_desc_t *weights_layer_desc,
+        const mkldnn_memory_desc_t *weights_iter_desc,
+        const mkldnn_memory_desc_t *weights_peephole_desc,
+        const mkldnn_memory_desc_t *weights_projection_desc,
+        const mkldnn_memory_desc_t *bias_desc,
+        const mkldnn_memory_desc_t *dst_layer_desc,
+        const mkldnn_memory_desc_t *dst_iter_desc);
+
+/// Sets the sequence lengths of a rnn descriptor @p rnn_desc initialized for
+/// forward propagation. @p seq_lengths_desc is a one dimensional #mkldnn_s32
+/// memory descriptor of size batch, which holds the number of elements of
+/// each sequence of the minibatch, between 0 and num_iterations. It is allowed
+/// to be initialized with #mkldnn_format_kind_any value of @p format_kind.
+///
+/// Sequence b is only computed for its first seq_lengths[b] iterations.
+/// dst_layer is zero past the end of each sequence, and dst_iter holds the
+/// states at the end of each sequence. Right to left directions start from
+/// the end of each sequence.
+///
+/// Inputs, in addition to those of mkldnn_rnn_forward_desc_init():
+///  - seq_lengths (#mkldnn_query_src_md, 2)
+mkldnn_status_t MKLDNN_API mkldnn_rnn_forward_desc_set_seq_lengths(
+        mkldnn_rnn_desc_t *rnn_desc,
+        const mkldnn_memory_desc_t *seq_lengths_desc);
+
 /// Initializes a rnn descriptor @p rnn_desc for backward propagation
 /// using @p prop_kind, @p rnn_cell_desc, @p direction, and memory descriptors.
 ///
@@ -1524,6 +1604,53 @@ mkldnn_status_t MKLDNN_API mkldnn_rnn_backward_desc_init(
 
 /// @}
 
+/// @addtogroup c_api_attention Attention
+/// A primitive to compute the attention of a sequence of queries over a
+/// sequence of keys and values, as used between the encoder and decoder of
+/// sequence to sequence models.
+///
+/// @sa @ref cpp_api_attention in @ref cpp_api
+/// @{
+
+/// Initializes an attention descriptor @p attention_desc for forward
+/// propagation using @p prop_kind, @p alg_kind, memory descriptors, and
+/// @p scale.
+///
+/// @p query_desc (Tq x N x C), @p key_desc (Tk x N x C), @p value_desc
+/// (Tk x N x Cv) and @p dst_desc (Tq x N x Cv) follow the layout of the RNN
+/// src_layer and dst_layer tensors, so the states produced by an RNN
+/// primitive in #mkldnn_tnc or #mkldnn_ntc format can be passed without a
+/// reorder. For every query, the scores against the keys of its sequence are
+/// scaled by @p scale, normalized with a softmax and used to weight the
+/// values.
+///
+/// @p key_lengths_desc is a one dimensional #mkldnn_s32 memory descriptor of
+/// size N, which holds the number of valid keys of each sequence, between 1
+/// and Tk. The keys past the end of a sequence are masked out of the
+/// softmax. It is allowed to either be @c NULL or point to a zero memory
+/// descriptor, in which case all the Tk keys are used.
+///
+/// @note All memory descriptors are allowed to be initialized with
+///       #mkldnn_format_kind_any value of @p format_kind.
+///
+/// Inputs:
+///  - query (#mkldnn_query_src_md, 0)
+///  - key (#mkldnn_query_src_md, 1)
+///  - value (#mkldnn_query_src_md, 2)
+///  - key_lengths (#mkldnn_query_src_md, 3), if used
+///
+/// Outputs:
+///  - dst (#mkldnn_query_dst_md, 0)
+mkldnn_status_t MKLDNN_API mkldnn_attention_forward_desc_init(
+        mkldnn_attention_desc_t *attention_desc, mkldnn_prop_kind_t prop_kind,
+        mkldnn_alg_kind_t alg_kind, const mkldnn_memory_desc_t *query_desc,
+        const mkldnn_memory_desc_t *key_desc,
+        const mkldnn_memory_desc_t *value_desc,
+        const mkldnn_memory_desc_t *key_lengths_desc,
+        const mkldnn_memory_desc_t *dst_desc, float scale);
+
+/// @}
+
 /// @}
 
 /// @addtogroup c_api_engine Engine operations
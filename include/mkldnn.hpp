@@ -142,6 +142,7 @@ public:
         batch_normalization = mkldnn_batch_normalization,
         inner_product = mkldnn_inner_product,
         rnn = mkldnn_rnn,
+        attention = mkldnn_attention,
     };
 
     primitive(const_mkldnn_primitive_desc_t c_pd);
@@ -238,6 +239,7 @@ enum class algorithm {
     convolution_auto = mkldnn_convolution_auto,
     convolution_direct = mkldnn_convolution_direct,
     convolution_winograd = mkldnn_convolution_winograd,
+    convolution_fft = mkldnn_convolution_fft,
     deconvolution_direct = mkldnn_deconvolution_direct,
     deconvolution_winograd = mkldnn_deconvolution_winograd,
     eltwise_relu = mkldnn_eltwise_relu,
@@ -259,7 +261,8 @@ enum class algorithm {
     vanilla_rnn = mkldnn_vanilla_rnn,
     vanilla_lstm = mkldnn_vanilla_lstm,
     vanilla_gru = mkldnn_vanilla_gru,
-    gru_linear_before_reset = mkldnn_gru_linear_before_reset
+    gru_linear_before_reset = mkldnn_gru_linear_before_reset,
+    attention_dot_product = mkldnn_attention_dot_product
 };
 
 inline mkldnn_alg_kind_t convert_to_c(algorithm aalgorithm) {
@@ -338,6 +341,7 @@ enum class query {
     batch_normalization_d = mkldnn_query_batch_normalization_d,
     inner_product_d = mkldnn_query_inner_product_d,
     rnn_d = mkldnn_query_rnn_d,
+    attention_d = mkldnn_query_attention_d,
 
     src_md = mkldnn_query_src_md,
     diff_src_md = mkldnn_query_diff_src_md,
@@ -584,6 +588,33 @@ struct primitive_attr: public handle<mkldnn_primitive_attr_t> {
                     (int)scales.size(), mask, &scales[0]),
                 "could not set rnn weights int scales");
     }
+
+    /// Sets the data type @p data_type in which the RNN workspace keeps the
+    /// gates and states passed from forward training to backward propagation.
+    /// Only #mkldnn_f32 (default) and #mkldnn_f16 are supported. The
+    /// computations are still done in f32.
+    /// @note
+    ///     The same data type must be set for the forward training and the
+    ///     backward primitive descriptors.
+    void set_rnn_workspace_data_type(mkldnn_data_type_t data_type)
+    {
+        error::wrap_c_api(mkldnn_primitive_attr_set_rnn_workspace_data_type(
+                    get(), data_type),
+                "could not set rnn workspace data type");
+    }
+
+    /// Sets the checkpoint @p interval of the RNN training workspace. With a
+    /// nonzero @p interval, no gates and only the cell states of every
+    /// @p interval-th iteration are stored, and backward recomputes the rest.
+    /// @note
+    ///     The same interval must be set for the forward training and the
+    ///     backward primitive descriptors.
+    void set_rnn_workspace_checkpoint(int interval)
+    {
+        error::wrap_c_api(mkldnn_primitive_attr_set_rnn_workspace_checkpoint(
+                    get(), interval),
+                "could not set rnn workspace checkpoint interval");
+    }
 };
 
 /// @}
@@ -977,6 +1008,7 @@ struct memory: public handle<mkldnn_memory_t> {
         ldigo = mkldnn_ldigo,
         ldgoi = mkldnn_ldgoi,
         ldgo = mkldnn_ldgo,
+        ldio = mkldnn_ldio,
         nCdhw16c = mkldnn_nCdhw16c,
         nCdhw4c = mkldnn_nCdhw4c,
         nCdhw8c = mkldnn_nCdhw8c,
@@ -3181,6 +3213,42 @@ struct rnn_forward : public primitive {
                     "could not create an RNN forward descriptor");
         }
 
+        /// Initializes an LSTM descriptor for forward propagation with
+        /// peephole connections and recurrent projection. @p
+        /// weights_peephole_desc and @p weights_projection_desc are allowed
+        /// to point to a zero memory descriptor, which would indicate that
+        /// the cell does not use them.
+        desc(prop_kind aprop_kind, rnn_cell::desc cell,
+                const rnn_direction direction,
+                const memory::desc &src_layer_desc,
+                const memory::desc &src_iter_desc,
+                const memory::desc &weights_layer_desc,
+                const memory::desc &weights_iter_desc,
+                const memory::desc &weights_peephole_desc,
+                const memory::desc &weights_projection_desc,
+                const memory::desc &bias_desc,
+                const memory::desc &dst_layer_desc,
+                const memory::desc &dst_iter_desc
+            ) {
+            error::wrap_c_api(mkldnn_lstm_forward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind), cell,
+                        mkldnn::convert_to_c(direction),
+                        &src_layer_desc.data, &src_iter_desc.data,
+                        &weights_layer_desc.data, &weights_iter_desc.data,
+                        &weights_peephole_desc.data,
+                        &weights_projection_desc.data, &bias_desc.data,
+                        &dst_layer_desc.data, &dst_iter_desc.data),
+                    "could not create an LSTM forward descriptor");
+        }
+
+        /// Sets the per minibatch entry sequence lengths, see
+        /// mkldnn_rnn_forward_desc_set_seq_lengths().
+        void set_seq_lengths(const memory::desc &seq_lengths_desc) {
+            error::wrap_c_api(mkldnn_rnn_forward_desc_set_seq_lengths(&data,
+                        &seq_lengths_desc.data),
+                    "could not set the sequence lengths of an RNN forward "
+                    "descriptor");
+        }
     };
 
     /// Primitive descriptor for RNN forward propagation.
@@ -3193,9 +3261,12 @@ struct rnn_forward : public primitive {
 
         REG_QUERY_MD(src_layer, src, 0);
         REG_QUERY_MD(src_iter, src, 1);
+        REG_QUERY_MD(src_seq_lengths, src, 2);
         REG_QUERY_MD(weights_layer, weights, 0);
         REG_QUERY_MD(weights_iter, weights, 1);
         REG_QUERY_MD(bias, weights, 2);
+        REG_QUERY_MD(weights_peephole, weights, 3);
+        REG_QUERY_MD(weights_projection, weights, 4);
         REG_QUERY_MD(dst_layer, dst, 0);
         REG_QUERY_MD(dst_iter, dst, 1);
         REG_QUERY_MD(workspace, workspace, 0);
@@ -3367,6 +3438,74 @@ struct shuffle_backward : public primitive {
 
 /// @}
 
+/// @addtogroup cpp_api_attention Attention
+/// A primitive to compute the attention of a sequence of queries over a
+/// sequence of keys and values.
+///
+/// @sa @ref c_api_attention in @ref c_api
+/// @{
+
+/// Attention for forward propagation.  Implements descriptor, primitive
+/// descriptor, and primitive.
+struct attention_forward : public primitive {
+
+    /// Descriptor for attention forward propagation.
+    struct desc {
+        mkldnn_attention_desc_t data;
+
+        /// Initializes an attention descriptor for forward propagation using
+        /// @p prop_kind, @p aalgorithm, memory descriptors, and @p scale.
+        /// @p key_lengths_desc is allowed to point to a zero memory
+        /// descriptor, which would indicate that all the keys are used.
+        desc(prop_kind aprop_kind, algorithm aalgorithm,
+                const memory::desc &query_desc,
+                const memory::desc &key_desc,
+                const memory::desc &value_desc,
+                const memory::desc &key_lengths_desc,
+                const memory::desc &dst_desc, float scale) {
+            error::wrap_c_api(mkldnn_attention_forward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind),
+                        mkldnn::convert_to_c(aalgorithm), &query_desc.data,
+                        &key_desc.data, &value_desc.data,
+                        &key_lengths_desc.data, &dst_desc.data, scale),
+                    "could not create an attention forward descriptor");
+        }
+
+        /// Initializes an attention descriptor for forward propagation
+        /// which uses all the keys of every sequence.
+        desc(prop_kind aprop_kind, algorithm aalgorithm,
+                const memory::desc &query_desc,
+                const memory::desc &key_desc,
+                const memory::desc &value_desc,
+                const memory::desc &dst_desc, float scale) {
+            error::wrap_c_api(mkldnn_attention_forward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind),
+                        mkldnn::convert_to_c(aalgorithm), &query_desc.data,
+                        &key_desc.data, &value_desc.data, nullptr,
+                        &dst_desc.data, scale),
+                    "could not create an attention forward descriptor");
+        }
+    };
+
+    /// Primitive descriptor for attention forward propagation.
+    struct primitive_desc : public mkldnn::primitive_desc {
+        primitive_desc(const desc &desc, const engine &e,
+                const primitive_attr &aattr = primitive_attr())
+            : mkldnn::primitive_desc(&desc.data, &aattr, e, nullptr) {}
+
+        REG_QUERY_MD(query, src, 0);
+        REG_QUERY_MD(key, src, 1);
+        REG_QUERY_MD(value, src, 2);
+        REG_QUERY_MD(key_lengths, src, 3);
+        REG_QUERY_MD(dst, dst, 0);
+        REG_QUERY_MD(scratchpad, scratchpad, 0);
+    };
+
+    attention_forward(const primitive_desc &pd): primitive(pd) {}
+};
+
+/// @}
+
 /// @} Primitives
 
 /// @} C++ API
@@ -387,6 +387,9 @@ typedef enum {
     ///    and output gate.
     ///  - For GRU cells, the gates order is update, reset and output gate.
     mkldnn_ldgo = mkldnn_abcd,
+    /// 4D LSTM projection tensor in the format (num_layers, num_directions,
+    /// num_channels_in_hidden_state, num_channels_in_recurrent_projection).
+    mkldnn_ldio = mkldnn_abcd,
 
     // Opaque data types, are not to be used explicitly
 
@@ -596,6 +599,8 @@ typedef enum {
     mkldnn_rnn,
     /// A matrix multiplication primitive.
     mkldnn_gemm,
+    /// An attention primitive.
+    mkldnn_attention,
 } mkldnn_primitive_kind_t;
 
 /// Kinds of algorithms.
@@ -607,6 +612,8 @@ typedef enum {
     mkldnn_convolution_winograd = 0x2,
     /// Convolution algorithm(either direct or Winograd) is chosen just in time
     mkldnn_convolution_auto = 0x3,
+    /// FFT convolution
+    mkldnn_convolution_fft = 0x4,
     /// Direct deconvolution
     mkldnn_deconvolution_direct = 0xa,
     /// Winograd deconvolution
@@ -656,6 +663,11 @@ typedef enum {
     /// Primitive expects 4 biases on input:
     /// \f$[b_{u}, b_{r}, b_{c_x}, b_{c_h}]\f$
     mkldnn_gru_linear_before_reset = 0x4fff,
+    /// Scaled dot-product attention
+    ///
+    /// Each query attends to the keys of its sequence with
+    /// \f[ dst_i = \sum_j softmax_j(scale \cdot q_i \cdot k_j) v_j \f]
+    mkldnn_attention_dot_product = 0x5fff,
 } mkldnn_alg_kind_t;
 
 /// Flags for batch-normalization primititve.
@@ -1193,8 +1205,43 @@ typedef struct {
     mkldnn_memory_desc_t diff_dst_layer_desc;
     /// Destination gradient iteration memory descriptor.
     mkldnn_memory_desc_t diff_dst_iter_desc;
+    /// LSTM peephole weights memory descriptor, zero if the cell has no
+    /// peephole connections.
+    mkldnn_memory_desc_t weights_peephole_desc;
+    /// LSTM projection weights memory descriptor, zero if the cell has no
+    /// recurrent projection.
+    mkldnn_memory_desc_t weights_projection_desc;
+    /// Sequence lengths memory descriptor, zero if all the sequences of the
+    /// minibatch have num_iterations elements.
+    mkldnn_memory_desc_t seq_lengths_desc;
 } mkldnn_rnn_desc_t;
 
+/// A descriptor of an attention operation.
+typedef struct {
+    /// The kind of primitive. Used for self-identifying the primitive
+    /// descriptor. Must be #mkldnn_attention.
+    mkldnn_primitive_kind_t primitive_kind;
+    /// The kind of propagation. Possible values: #mkldnn_forward_training
+    /// and #mkldnn_forward_inference.
+    mkldnn_prop_kind_t prop_kind;
+    /// The kind of attention algorithm. Possible values:
+    /// #mkldnn_attention_dot_product.
+    mkldnn_alg_kind_t alg_kind;
+    /// Query memory descriptor (Tq x N x C).
+    mkldnn_memory_desc_t query_desc;
+    /// Key memory descriptor (Tk x N x C).
+    mkldnn_memory_desc_t key_desc;
+    /// Value memory descriptor (Tk x N x Cv).
+    mkldnn_memory_desc_t value_desc;
+    /// Key lengths memory descriptor, zero if all the sequences of the
+    /// minibatch have Tk keys.
+    mkldnn_memory_desc_t key_lengths_desc;
+    /// Destination memory descriptor (Tq x N x Cv).
+    mkldnn_memory_desc_t dst_desc;
+    /// The factor applied to the scores before the softmax.
+    float scale;
+} mkldnn_attention_desc_t;
+
 /// Transposition settings for GEMM operation
 typedef enum {
     /// Do not transpose matrix.
@@ -1342,9 +1389,18 @@ typedef const struct mkldnn_primitive *const_mkldnn_primitive_t;
 #define MKLDNN_ARG_SRC                  MKLDNN_ARG_SRC_0
 #define MKLDNN_ARG_SRC_LAYER            MKLDNN_ARG_SRC_0
 #define MKLDNN_ARG_FROM                 MKLDNN_ARG_SRC_0
+#define MKLDNN_ARG_SRC_QUERY            MKLDNN_ARG_SRC_0
 
 #define MKLDNN_ARG_SRC_1                2
 #define MKLDNN_ARG_SRC_ITER             MKLDNN_ARG_SRC_1
+#define MKLDNN_ARG_SRC_KEY              MKLDNN_ARG_SRC_1
+
+#define MKLDNN_ARG_SRC_2                3
+#define MKLDNN_ARG_SRC_SEQ_LENGTHS      MKLDNN_ARG_SRC_2
+#define MKLDNN_ARG_SRC_VALUE            MKLDNN_ARG_SRC_2
+
+#define MKLDNN_ARG_SRC_3                4
+#define MKLDNN_ARG_SRC_KEY_LENGTHS      MKLDNN_ARG_SRC_3
 
 #define MKLDNN_ARG_DST_0                17
 #define MKLDNN_ARG_DST                  MKLDNN_ARG_DST_0
@@ -1362,6 +1418,12 @@ typedef const struct mkldnn_primitive *const_mkldnn_primitive_t;
 #define MKLDNN_ARG_WEIGHTS_1            34
 #define MKLDNN_ARG_WEIGHTS_ITER         MKLDNN_ARG_WEIGHTS_1
 
+#define MKLDNN_ARG_WEIGHTS_2            35
+#define MKLDNN_ARG_WEIGHTS_PEEPHOLE     MKLDNN_ARG_WEIGHTS_2
+
+#define MKLDNN_ARG_WEIGHTS_3            36
+#define MKLDNN_ARG_WEIGHTS_PROJECTION   MKLDNN_ARG_WEIGHTS_3
+
 #define MKLDNN_ARG_BIAS                 41
 
 #define MKLDNN_ARG_MEAN                 49
@@ -1477,6 +1539,7 @@ typedef enum {
     mkldnn_query_inner_product_d, ///< inner product descriptor
     mkldnn_query_rnn_d, ///< rnn descriptor
     mkldnn_query_gemm_d, ///< GEMM descriptor
+    mkldnn_query_attention_d, ///< attention descriptor
 
     // memory descriptor section
     mkldnn_query_some_md = 128, ///< stub
@@ -0,0 +1,82 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::utils;
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::prop_kind;
+using namespace mkldnn::impl::alg_kind;
+using namespace mkldnn::impl::types;
+
+status_t mkldnn_attention_forward_desc_init(attention_desc_t *attention_desc,
+        prop_kind_t prop_kind, alg_kind_t alg_kind,
+        const memory_desc_t *query_desc, const memory_desc_t *key_desc,
+        const memory_desc_t *value_desc, const memory_desc_t *key_lengths_desc,
+        const memory_desc_t *dst_desc, float scale) {
+    bool args_ok = true
+        && !any_null(attention_desc, query_desc, key_desc, value_desc,
+                dst_desc)
+        && one_of(prop_kind, forward_training, forward_inference)
+        && alg_kind == attention_dot_product;
+    if (!args_ok) return invalid_arguments;
+
+    auto ad = attention_desc_t();
+    ad.primitive_kind = primitive_kind::attention;
+    ad.prop_kind = prop_kind;
+    ad.alg_kind = alg_kind;
+    ad.query_desc = *query_desc;
+    ad.key_desc = *key_desc;
+    ad.value_desc = *value_desc;
+    ad.key_lengths_desc = key_lengths_desc ? *key_lengths_desc : zero_md();
+    ad.dst_desc = *dst_desc;
+    ad.scale = scale;
+
+    // Tq x N x C queries attend to Tk x N x C keys and Tk x N x Cv values
+    const auto &q = ad.query_desc, &k = ad.key_desc, &v = ad.value_desc,
+          &d = ad.dst_desc, &kl = ad.key_lengths_desc;
+    bool consistency = true
+        && everyone_is(3, q.ndims, k.ndims, v.ndims, d.ndims)
+        && array_product(q.dims, 3) > 0
+        && array_product(k.dims, 3) > 0
+        && array_product(v.dims, 3) > 0
+        && everyone_is(q.dims[1], k.dims[1], v.dims[1], d.dims[1])
+        && q.dims[2] == k.dims[2]
+        && k.dims[0] == v.dims[0]
+        && d.dims[0] == q.dims[0]
+        && d.dims[2] == v.dims[2];
+    if (!consistency) return invalid_arguments;
+
+    // one length per minibatch entry
+    if (!memory_desc_wrapper(kl).is_zero()) {
+        consistency = true
+            && kl.ndims == 1
+            && kl.dims[0] == q.dims[1]
+            && kl.data_type == data_type::s32;
+        if (!consistency) return invalid_arguments;
+    }
+
+    *attention_desc = ad;
+    return success;
+}
+
+// vim: et ts=5 sw=4 cindent cino^=l0,\:0,N-s
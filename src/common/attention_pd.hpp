@@ -0,0 +1,149 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef ATTENTION_PD_HPP
+#define ATTENTION_PD_HPP
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "type_helpers.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+struct attention_fwd_pd_t;
+
+struct attention_pd_t: public primitive_desc_t {
+    static constexpr auto base_pkind = primitive_kind::attention;
+
+    attention_pd_t(engine_t *engine,
+            const attention_desc_t *adesc,
+            const primitive_attr_t *attr,
+            const attention_fwd_pd_t *hint_fwd_pd)
+        : primitive_desc_t(engine, attr, base_pkind)
+        , desc_(*adesc)
+        , hint_fwd_pd_(hint_fwd_pd)
+    {}
+
+    const attention_desc_t *desc() const { return &desc_; }
+    virtual const op_desc_t *op_desc() const override
+    { return reinterpret_cast<const op_desc_t *>(this->desc()); }
+    virtual void init_info() override { impl::init_info(this, this->info_); }
+
+    virtual status_t query(query_t what, int idx, void *result) const override {
+        switch (what) {
+        case query::attention_d:
+            *(const attention_desc_t**)result = desc(); break;
+        default: return primitive_desc_t::query(what, idx, result);
+        }
+        return status::success;
+    }
+
+    /* common attention aux functions */
+
+    dim_t Tq() const { return desc_.query_desc.dims[0]; }
+    dim_t Tk() const { return desc_.key_desc.dims[0]; }
+    dim_t MB() const { return desc_.query_desc.dims[1]; }
+    dim_t C() const { return desc_.query_desc.dims[2]; }
+    dim_t Cv() const { return desc_.value_desc.dims[2]; }
+
+    float scale() const { return desc_.scale; }
+
+    bool with_key_lengths() const
+    { return !memory_desc_wrapper(desc_.key_lengths_desc).is_zero(); }
+
+    bool is_fwd() const {
+        return utils::one_of(desc_.prop_kind, prop_kind::forward_training,
+                prop_kind::forward_inference);
+    }
+
+protected:
+    attention_desc_t desc_;
+    const attention_fwd_pd_t *hint_fwd_pd_;
+};
+
+struct attention_fwd_pd_t: public attention_pd_t {
+    typedef attention_fwd_pd_t base_class;
+    typedef attention_fwd_pd_t hint_class;
+
+    attention_fwd_pd_t(engine_t *engine,
+            const attention_desc_t *adesc,
+            const primitive_attr_t *attr,
+            const attention_fwd_pd_t *hint_fwd_pd)
+        : attention_pd_t(engine, adesc, attr, hint_fwd_pd)
+        , query_md_(desc_.query_desc)
+        , key_md_(desc_.key_desc)
+        , value_md_(desc_.value_desc)
+        , key_lengths_md_(desc_.key_lengths_desc)
+        , dst_md_(desc_.dst_desc)
+    {}
+
+    virtual arg_usage_t arg_usage(int arg) const override {
+        if (utils::one_of(arg, MKLDNN_ARG_SRC_QUERY, MKLDNN_ARG_SRC_KEY,
+                    MKLDNN_ARG_SRC_VALUE))
+            return arg_usage_t::input;
+
+        if (arg == MKLDNN_ARG_SRC_KEY_LENGTHS && with_key_lengths())
+            return arg_usage_t::input;
+
+        if (arg == MKLDNN_ARG_DST)
+            return arg_usage_t::output;
+
+        return primitive_desc_t::arg_usage(arg);
+    }
+
+    virtual const memory_desc_t *src_md(int index = 0) const override {
+        if (index == 0) return &query_md_;
+        if (index == 1) return &key_md_;
+        if (index == 2) return &value_md_;
+        if (index == 3 && with_key_lengths()) return &key_lengths_md_;
+        return nullptr;
+    }
+    virtual const memory_desc_t *dst_md(int index = 0) const override
+    { return index == 0 ? &dst_md_ : nullptr; }
+
+    virtual int n_inputs() const override { return 3 + with_key_lengths(); }
+    virtual int n_outputs() const override { return 1; }
+
+protected:
+    memory_desc_t query_md_;
+    memory_desc_t key_md_;
+    memory_desc_t value_md_;
+    memory_desc_t key_lengths_md_;
+    memory_desc_t dst_md_;
+
+    /* The queries, keys, values and destination are read as Tx x N x C
+     * matrices with a unit channel stride, which covers the tnc and ntc
+     * states of the RNN primitive. Formats left as any become tnc. */
+    status_t set_default_formats() {
+        using namespace format_tag;
+        for (auto md : {&query_md_, &key_md_, &value_md_, &dst_md_})
+            if (md->format_kind == format_kind::any)
+                CHECK(memory_desc_init_by_tag(*md, tnc));
+        if (key_lengths_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(key_lengths_md_, x));
+        return status::success;
+    }
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -62,6 +62,7 @@ namespace alg_kind {
     const alg_kind_t convolution_auto = mkldnn_convolution_auto;
     const alg_kind_t convolution_direct = mkldnn_convolution_direct;
     const alg_kind_t convolution_winograd = mkldnn_convolution_winograd;
+    const alg_kind_t convolution_fft = mkldnn_convolution_fft;
     const alg_kind_t deconvolution_direct = mkldnn_deconvolution_direct;
     const alg_kind_t deconvolution_winograd = mkldnn_deconvolution_winograd;
     const alg_kind_t eltwise_relu = mkldnn_eltwise_relu;
@@ -84,6 +85,7 @@ namespace alg_kind {
     const alg_kind_t vanilla_lstm = mkldnn_vanilla_lstm;
     const alg_kind_t vanilla_gru = mkldnn_vanilla_gru;
     const alg_kind_t gru_linear_before_reset = mkldnn_gru_linear_before_reset;
+    const alg_kind_t attention_dot_product = mkldnn_attention_dot_product;
 }
 
 using data_type_t = mkldnn_data_type_t;
@@ -273,6 +275,7 @@ namespace format_tag {
     const format_tag_t ldigo = mkldnn_ldigo;
     const format_tag_t ldgoi = mkldnn_ldgoi;
     const format_tag_t ldgo = mkldnn_ldgo;
+    const format_tag_t ldio = mkldnn_ldio;
     const format_tag_t nCdhw16c = mkldnn_nCdhw16c;
     const format_tag_t nCdhw4c = mkldnn_nCdhw4c;
     const format_tag_t nCdhw8c = mkldnn_nCdhw8c;
@@ -423,6 +426,7 @@ namespace primitive_kind {
     const primitive_kind_t inner_product = mkldnn_inner_product;
     const primitive_kind_t rnn = mkldnn_rnn;
     const primitive_kind_t gemm = mkldnn_gemm;
+    const primitive_kind_t attention = mkldnn_attention;
 }
 
 using query_t = mkldnn_query_t;
@@ -455,6 +459,7 @@ namespace query {
     const query_t inner_product_d = mkldnn_query_inner_product_d;
     const query_t rnn_d = mkldnn_query_rnn_d;
     const query_t gemm_d = mkldnn_query_gemm_d;
+    const query_t attention_d = mkldnn_query_attention_d;
 
     const query_t some_md = mkldnn_query_some_md;
     const query_t src_md = mkldnn_query_src_md;
@@ -487,6 +492,8 @@ using rnn_direction_t = mkldnn_rnn_direction_t;
 using rnn_cell_desc_t = mkldnn_rnn_cell_desc_t;
 using rnn_desc_t = mkldnn_rnn_desc_t;
 
+using attention_desc_t = mkldnn_attention_desc_t;
+
 /* Internal type, declared in gemm_types.hpp */
 using gemm_desc_t = mkldnn_gemm_desc_t;
 
@@ -508,6 +515,7 @@ struct op_desc_t {
         inner_product_desc_t inner_product;
         rnn_desc_t rnn;
         gemm_desc_t gemm;
+        attention_desc_t attention;
     };
 
     op_desc_t(const primitive_kind_t &_): kind(_) {}
@@ -529,6 +537,7 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(inner_product_desc_t, inner_product);
     DECL_CTOR_AND_CONVERTERS(rnn_desc_t, rnn);
     DECL_CTOR_AND_CONVERTERS(gemm_desc_t, gemm);
+    DECL_CTOR_AND_CONVERTERS(attention_desc_t, attention);
 
 #   undef DECL_CTOR_AND_CONVERTERS
 };
@@ -557,6 +566,8 @@ namespace transpose {
 }
 
 /* forward declaration of the internal primitive_desc types */
+struct attention_fwd_pd_t;
+struct attention_pd_t;
 struct batch_normalization_bwd_pd_t;
 struct batch_normalization_fwd_pd_t;
 struct batch_normalization_pd_t;
@@ -0,0 +1,345 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <mutex>
+#include <vector>
+
+#include "mkldnn.h"
+#include "mkldnn_debug.h"
+
+#include "c_types_map.hpp"
+#include "memory.hpp"
+#include "mkldnn_thread.hpp"
+#include "primitive.hpp"
+#include "stream.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+#include "verbose.hpp"
+
+#include "convolution_tuning.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+namespace {
+
+const int path_len = 1024;
+const int key_len = 1024;
+const int impl_len = 64;
+
+struct conv_tuning_entry_t {
+    char key[key_len];
+    int max_nthr;
+    alg_kind_t alg;
+    char impl[impl_len];
+};
+
+char tuning_file[path_len] = {0};
+bool tuning_mode = false;
+
+std::vector<conv_tuning_entry_t> tuning_table;
+std::mutex tuning_mutex;
+std::once_flag tuning_init_flag;
+
+bool str2alg(const char *str, alg_kind_t *alg) {
+    const alg_kind_t algs[] = {alg_kind::convolution_direct,
+        alg_kind::convolution_winograd, alg_kind::convolution_fft};
+    for (auto a : algs) {
+        if (!strcmp(str, mkldnn_alg_kind2str(a))) {
+            *alg = a;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_entry(const char *line, conv_tuning_entry_t *e) {
+    char alg[32];
+    int nitems = sscanf(line, "%1023s %d %31s %63s", e->key, &e->max_nthr,
+            alg, e->impl);
+    return nitems == 4 && str2alg(alg, &e->alg);
+}
+
+void load_table() {
+    tuning_mode = getenv_int("MKLDNN_CONV_TUNING_MODE") == 1;
+
+    if (getenv("MKLDNN_CONV_TUNING_FILE", tuning_file, path_len) <= 0) {
+        tuning_file[0] = '\0';
+        return;
+    }
+
+    FILE *fp = fopen(tuning_file, "r");
+    if (!fp)
+        return;
+
+    char line[key_len + 128];
+    while (fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+        conv_tuning_entry_t e;
+        if (parse_entry(line, &e))
+            tuning_table.push_back(e);
+    }
+
+    fclose(fp);
+}
+
+// Describes everything in the descriptor and the attributes that may change
+// which implementation is the fastest one.
+void init_key(char *key, const convolution_desc_t &cd,
+        const primitive_attr_t &attr) {
+    using namespace prop_kind;
+
+    int len = 0;
+    auto append = [&](const char *str) {
+        len += snprintf(key + len, nstl::max(key_len - len, 0), "%s", str);
+    };
+    auto append_md = [&](const memory_desc_t &md) {
+        char str[key_len];
+        append(",");
+        if (mkldnn_md2fmt_str(str, sizeof(str), &md) >= 0) append(str);
+        append(",");
+        if (mkldnn_md2dim_str(str, sizeof(str), &md) >= 0) append(str);
+    };
+    auto append_dims = [&](const char *name, const dims_t dims, int n) {
+        char str[32];
+        append(name);
+        for (int d = 0; d < n; ++d) {
+            snprintf(str, sizeof(str), d ? "x%lld" : "%lld",
+                    (long long)dims[d]);
+            append(str);
+        }
+    };
+
+    const bool bwd_d = cd.prop_kind == backward_data;
+    const bool bwd_w = cd.prop_kind == backward_weights;
+    const bool fwd = utils::one_of(cd.prop_kind, forward_training,
+            forward_inference);
+
+    append(mkldnn_prop_kind2str(cd.prop_kind));
+    append_md(bwd_d ? cd.diff_src_desc : cd.src_desc);
+    append_md(bwd_w ? cd.diff_weights_desc : cd.weights_desc);
+    append_md(bwd_w ? cd.diff_bias_desc : cd.bias_desc);
+    append_md(fwd ? cd.dst_desc : cd.diff_dst_desc);
+
+    const int sp_ndims = cd.src_desc.ndims - 2;
+    append_dims(",s", cd.strides, sp_ndims);
+    append_dims(",d", cd.dilates, sp_ndims);
+    append_dims(",pl", cd.padding[0], sp_ndims);
+    append_dims(",pr", cd.padding[1], sp_ndims);
+
+    if (!attr.output_scales_.has_default_values()) {
+        char str[32];
+        snprintf(str, sizeof(str), ",oscale%d", attr.output_scales_.mask_);
+        append(str);
+    }
+
+    const auto &p = attr.post_ops_;
+    for (int i = 0; i < p.len_; ++i) {
+        append(",");
+        append(p.entry_[i].is_sum(false) ? "sum"
+                : mkldnn_alg_kind2str(p.entry_[i].eltwise.alg));
+    }
+}
+
+bool find_entry(const char *key, int max_nthr, conv_tuning_entry_t *entry) {
+    // The table is only modified in tuning mode, so the common case does not
+    // need to lock.
+    std::unique_lock<std::mutex> lock(tuning_mutex, std::defer_lock);
+    if (tuning_mode)
+        lock.lock();
+
+    for (const auto &e : tuning_table) {
+        if (e.max_nthr == max_nthr && !strcmp(e.key, key)) {
+            *entry = e;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void record_entry(const conv_tuning_entry_t &e) {
+    std::lock_guard<std::mutex> guard(tuning_mutex);
+
+    tuning_table.push_back(e);
+
+    if (tuning_file[0] == '\0')
+        return;
+
+    FILE *fp = fopen(tuning_file, "a");
+    if (!fp)
+        return;
+
+    fprintf(fp, "%s %d %s %s\n", e.key, e.max_nthr,
+            mkldnn_alg_kind2str(e.alg), e.impl);
+
+    fclose(fp);
+}
+
+// Returns the best of a few executions of the primitive on zero filled
+// buffers in milliseconds, or a negative value if it cannot be executed.
+double time_pd(const primitive_desc_t *pd, engine_t *engine) {
+    const int n_runs = 3;
+
+    primitive_t *p = nullptr;
+    if (pd->create_primitive(&p) != status::success)
+        return -1.;
+
+    stream_t *stream = nullptr;
+    if (mkldnn_stream_create(&stream, engine, mkldnn_stream_default_flags)
+            != status::success) {
+        delete p;
+        return -1.;
+    }
+
+    const struct { int arg; const memory_desc_t *md; } conv_args[] = {
+        {MKLDNN_ARG_SRC, pd->src_md()},
+        {MKLDNN_ARG_DIFF_SRC, pd->diff_src_md()},
+        {MKLDNN_ARG_WEIGHTS, pd->weights_md(0)},
+        {MKLDNN_ARG_DIFF_WEIGHTS, pd->diff_weights_md(0)},
+        {MKLDNN_ARG_BIAS, pd->weights_md(1)},
+        {MKLDNN_ARG_DIFF_BIAS, pd->diff_weights_md(1)},
+        {MKLDNN_ARG_DST, pd->dst_md()},
+        {MKLDNN_ARG_DIFF_DST, pd->diff_dst_md()},
+    };
+
+    bool ok = true;
+    std::vector<memory_t *> mems;
+    std::vector<mkldnn_exec_arg_t> args;
+    for (const auto &a : conv_args) {
+        if (pd->arg_usage(a.arg) == primitive_desc_t::arg_usage_t::unused)
+            continue;
+        memory_t *mem = nullptr;
+        ok = a.md != nullptr && mkldnn_memory_create(&mem, a.md, engine,
+                MKLDNN_MEMORY_ALLOCATE) == status::success;
+        if (!ok) break;
+        mems.push_back(mem);
+        args.push_back({a.arg, mem});
+
+        void *handle = nullptr;
+        mem->get_data_handle(&handle);
+        if (handle) memset(handle, 0, memory_desc_wrapper(a.md).size());
+    }
+
+    double best = -1.;
+    for (int run = 0; ok && run <= n_runs; ++run) {
+        double ms = get_msec();
+        ok = mkldnn_primitive_execute(p, stream, (int)args.size(),
+                args.data()) == status::success;
+        stream->wait();
+        ms = get_msec() - ms;
+        // the first run only warms up the caches
+        if (ok && run > 0 && (best < 0 || ms < best)) best = ms;
+    }
+
+    for (auto mem : mems)
+        delete mem;
+    delete stream;
+    delete p;
+
+    return ok ? best : -1.;
+}
+
+}
+
+bool conv_tuning_enabled() {
+    std::call_once(tuning_init_flag, load_table);
+    return tuning_mode || !tuning_table.empty();
+}
+
+status_t conv_tuning_pd_create(primitive_desc_t **pd,
+        const convolution_desc_t *desc, const primitive_attr_t *attr,
+        engine_t *engine, const primitive_desc_t *hint_fwd_pd) {
+    if (!conv_tuning_enabled())
+        return status::unimplemented;
+
+    const primitive_attr_t default_attr;
+    if (attr == nullptr)
+        attr = &default_attr;
+
+    conv_tuning_entry_t entry;
+    init_key(entry.key, *desc, *attr);
+    entry.max_nthr = mkldnn_get_max_threads();
+
+    const auto impl_list = engine->get_implementation_list();
+
+    conv_tuning_entry_t e;
+    if (find_entry(entry.key, entry.max_nthr, &e)) {
+        convolution_desc_t cd = *desc;
+        cd.alg_kind = e.alg;
+        for (auto create = impl_list; *create; ++create) {
+            primitive_desc_t *candidate = nullptr;
+            if ((*create)(&candidate, (const op_desc_t *)&cd, attr, engine,
+                        hint_fwd_pd) != status::success)
+                continue;
+            if (!strcmp(candidate->name(), e.impl)) {
+                *pd = candidate;
+                return status::success;
+            }
+            delete candidate;
+        }
+        // the recorded implementation is not available anymore
+        return status::unimplemented;
+    }
+
+    if (!tuning_mode)
+        return status::unimplemented;
+
+    primitive_desc_t *best = nullptr;
+    double best_ms = 0.;
+    const alg_kind_t algs[] = {alg_kind::convolution_direct,
+        alg_kind::convolution_winograd, alg_kind::convolution_fft};
+    for (auto alg : algs) {
+        convolution_desc_t cd = *desc;
+        cd.alg_kind = alg;
+        for (auto create = impl_list; *create; ++create) {
+            primitive_desc_t *candidate = nullptr;
+            if ((*create)(&candidate, (const op_desc_t *)&cd, attr, engine,
+                        hint_fwd_pd) != status::success)
+                continue;
+
+            // reference implementations are only timed if nothing else
+            // accepts the problem
+            const bool is_ref = !strncmp(candidate->name(), "ref", 3);
+            const double ms = best && is_ref ? -1. : time_pd(candidate, engine);
+            if (ms >= 0. && (!best || ms < best_ms)) {
+                delete best;
+                best = candidate;
+                best_ms = ms;
+                entry.alg = alg;
+            } else {
+                delete candidate;
+            }
+        }
+    }
+
+    if (!best)
+        return status::unimplemented;
+
+    snprintf(entry.impl, impl_len, "%s", best->name());
+    record_entry(entry);
+
+    *pd = best;
+    return status::success;
+}
+
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
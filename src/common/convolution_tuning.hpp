@@ -0,0 +1,59 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CONVOLUTION_TUNING_HPP
+#define CONVOLUTION_TUNING_HPP
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "primitive_desc.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+// Measured algorithm choices for convolution_auto.
+//
+// With MKLDNN_CONV_TUNING_MODE set to 1, the first creation of a
+// convolution_auto primitive descriptor for a given problem times every
+// implementation that accepts the problem with the direct, winograd and fft
+// algorithms, and keeps the fastest one in an in-process table that serves
+// later creations of the same problem. If MKLDNN_CONV_TUNING_FILE is set as
+// well, the table is read from that file and new entries are appended to it.
+// Setting only MKLDNN_CONV_TUNING_FILE uses the recorded choices without
+// tuning new problems. Each line of the file holds one entry:
+//
+//   key max_nthr alg impl
+//
+// where key describes the descriptor and the attributes, e.g.
+// "forward_training,f32::any::f0,2x64x56x56,...,s1x1,d0x0,pl1x1,pr1x1 28
+// convolution_winograd jit_wino:avx2". Lines starting with '#' are ignored.
+// Entries only apply if max_nthr matches mkldnn_get_max_threads().
+
+// Returns true if convolution_auto should be resolved by the tuning table.
+bool conv_tuning_enabled();
+
+// Creates the primitive descriptor recorded for the problem, tuning it first
+// in tuning mode. Returns unimplemented if there is no recorded choice and
+// the problem cannot be tuned, in which case the caller falls back to the
+// heuristics of the implementations.
+status_t conv_tuning_pd_create(primitive_desc_t **pd,
+        const convolution_desc_t *desc, const primitive_attr_t *attr,
+        engine_t *engine, const primitive_desc_t *hint_fwd_pd);
+
+}
+}
+
+#endif // CONVOLUTION_TUNING_HPP
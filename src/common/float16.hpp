@@ -102,10 +102,9 @@ inline float16_t &float16_t::operator=(float f) {
     } else {
         // Underflow. Scale the input float, converting it
         // into an equivalent denormal.
-        float ff = f * raw_to_float(0x01000000);
-        uint32_t ii = float_to_raw(ff);
+        float ff = f * raw_to_float(0x4B800000);
         ee = 0;
-        mm = ii;
+        mm = (uint32_t)std::nearbyint(std::fabs(ff));
     }
 
     this->raw = (ss << 15) | (ee << 10) | mm;
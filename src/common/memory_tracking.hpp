@@ -144,6 +144,7 @@ namespace memory_tracking {
 namespace names {
 enum {
     key_none = 0,
+    key_attention_scores,
     key_bnorm_tmp_mean,
     key_bnorm_tmp_var,
     key_bnorm_tmp_diff_ss,
@@ -155,6 +156,11 @@ enum {
     key_concat_optrs,
     key_conv_adjusted_scales,
     key_conv_bia_reduction,
+    key_conv_dst_reduction,
+    key_conv_fft_buf,
+    key_conv_fft_M,
+    key_conv_fft_U,
+    key_conv_fft_V,
     key_conv_gemm_col,
     key_conv_gemm_imtr,
     key_conv_int_dat_in_acc_dt,
@@ -178,6 +184,7 @@ enum {
     key_rnn_ptrs_bia,
     key_rnn_ptrs_wei_layer,
     key_rnn_ptrs_wei_iter,
+    key_rnn_seq_lengths,
     key_softmax_reduction,
     key_wino_U,
     key_wino_V,
@@ -208,6 +208,7 @@ const char *mkldnn_fmt_tag2str(mkldnn_format_tag_t v) {
     if (v == mkldnn_ldigo) return "ldigo";
     if (v == mkldnn_ldgoi) return "ldgoi";
     if (v == mkldnn_ldgo) return "ldgo";
+    if (v == mkldnn_ldio) return "ldio";
     if (v == mkldnn_nCdhw16c) return "nCdhw16c";
     if (v == mkldnn_nCdhw4c) return "nCdhw4c";
     if (v == mkldnn_nCdhw8c) return "nCdhw8c";
@@ -348,6 +349,7 @@ const char *mkldnn_prim_kind2str(mkldnn_primitive_kind_t v) {
     if (v == mkldnn_inner_product) return "inner_product";
     if (v == mkldnn_rnn) return "rnn";
     if (v == mkldnn_gemm) return "gemm";
+    if (v == mkldnn_attention) return "attention";
     assert(!"unknown prim_kind");
     return "unknown prim_kind";
 }
@@ -357,6 +359,7 @@ const char *mkldnn_alg_kind2str(mkldnn_alg_kind_t v) {
     if (v == mkldnn_convolution_direct) return "convolution_direct";
     if (v == mkldnn_convolution_winograd) return "convolution_winograd";
     if (v == mkldnn_convolution_auto) return "convolution_auto";
+    if (v == mkldnn_convolution_fft) return "convolution_fft";
     if (v == mkldnn_deconvolution_direct) return "deconvolution_direct";
     if (v == mkldnn_deconvolution_winograd) return "deconvolution_winograd";
     if (v == mkldnn_eltwise_relu) return "eltwise_relu";
@@ -379,6 +382,7 @@ const char *mkldnn_alg_kind2str(mkldnn_alg_kind_t v) {
     if (v == mkldnn_vanilla_lstm) return "vanilla_lstm";
     if (v == mkldnn_vanilla_gru) return "vanilla_gru";
     if (v == mkldnn_gru_linear_before_reset) return "gru_linear_before_reset";
+    if (v == mkldnn_attention_dot_product) return "attention_dot_product";
     assert(!"unknown alg_kind");
     return "unknown alg_kind";
 }
@@ -72,6 +72,7 @@ PKIND_TRAITS_INST(batch_normalization);
 PKIND_TRAITS_INST(inner_product);
 PKIND_TRAITS_INST(rnn);
 PKIND_TRAITS_INST(gemm);
+PKIND_TRAITS_INST(attention);
 #undef PKIND_TRAITS_INST
 
 }
@@ -288,3 +288,24 @@ status_t mkldnn_primitive_attr_set_rnn_weights_qparams(
 
     return attr->rnn_weights_qparams_.set(count, mask, scales);
 }
+
+status_t mkldnn_primitive_attr_set_rnn_workspace_data_type(
+        primitive_attr_t *attr, data_type_t data_type) {
+    bool ok = attr != nullptr
+        && one_of(data_type, data_type::f32, data_type::f16);
+    if (!ok)
+        return invalid_arguments;
+
+    attr->rnn_workspace_data_type_ = data_type;
+    return success;
+}
+
+status_t mkldnn_primitive_attr_set_rnn_workspace_checkpoint(
+        primitive_attr_t *attr, int interval) {
+    bool ok = attr != nullptr && interval >= 0;
+    if (!ok)
+        return invalid_arguments;
+
+    attr->rnn_workspace_checkpoint_ = interval;
+    return success;
+}
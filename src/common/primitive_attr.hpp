@@ -152,6 +152,8 @@ struct mkldnn_post_ops: public mkldnn::impl::c_compatible {
 struct mkldnn_primitive_attr: public mkldnn::impl::c_compatible {
     mkldnn_primitive_attr()
         : scratchpad_mode_(mkldnn::impl::scratchpad_mode::library)
+        , rnn_workspace_data_type_(mkldnn::impl::data_type::f32)
+        , rnn_workspace_checkpoint_(0)
     {}
 
     mkldnn_primitive_attr *clone() const
@@ -165,7 +167,9 @@ struct mkldnn_primitive_attr: public mkldnn::impl::c_compatible {
             && output_scales_.has_default_values()
             && post_ops_.has_default_values()
             && rnn_data_qparams_.has_default_values()
-            && rnn_weights_qparams_.has_default_values();
+            && rnn_weights_qparams_.has_default_values()
+            && rnn_workspace_data_type_ == mkldnn::impl::data_type::f32
+            && rnn_workspace_checkpoint_ == 0;
     }
 
     mkldnn::impl::status_t set_scratchpad_mode(
@@ -178,6 +182,8 @@ struct mkldnn_primitive_attr: public mkldnn::impl::c_compatible {
     mkldnn::impl::post_ops_t post_ops_;
     mkldnn::impl::rnn_data_qparams_t rnn_data_qparams_;
     mkldnn::impl::scales_t rnn_weights_qparams_;
+    mkldnn::impl::data_type_t rnn_workspace_data_type_;
+    int rnn_workspace_checkpoint_;
 };
 
 #endif
@@ -23,6 +23,7 @@
 #include "primitive_desc.hpp"
 #include "type_helpers.hpp"
 #include "primitive_iterator.hpp"
+#include "convolution_tuning.hpp"
 
 using namespace mkldnn::impl;
 using namespace mkldnn::impl::status;
@@ -79,6 +80,15 @@ status_t mkldnn_primitive_desc_create(primitive_desc_t **primitive_desc,
         engine_t *engine, const primitive_desc_t *hint_fwd_pd) {
     const op_desc_t *op_desc = (const op_desc_t *)c_op_desc;
 
+    if (op_desc->kind == primitive_kind::convolution
+            && op_desc->convolution.alg_kind == alg_kind::convolution_auto
+            && engine->kind() == engine_kind::cpu && conv_tuning_enabled()) {
+        primitive_desc_t *pd = nullptr;
+        if (conv_tuning_pd_create(&pd, &op_desc->convolution, attr, engine,
+                    hint_fwd_pd) == success)
+            return safe_ptr_assign<primitive_desc_t>(*primitive_desc, pd);
+    }
+
     mkldnn_primitive_desc_iterator it(engine, op_desc, attr, hint_fwd_pd);
     ++it;
     if (it == it.end()) return unimplemented;
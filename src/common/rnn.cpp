@@ -47,6 +47,9 @@ rnn_desc_t zero_rnn_desc() {
     rd.diff_bias_desc = zero_md();
     rd.diff_dst_layer_desc = zero_md();
     rd.diff_dst_iter_desc = zero_md();
+    rd.weights_peephole_desc = zero_md();
+    rd.weights_projection_desc = zero_md();
+    rd.seq_lengths_desc = zero_md();
     return rd;
 }
 }
@@ -130,7 +133,6 @@ status_t check_data_type_consistency_fwd(const rnn_cell_desc_t *rnn_cell_desc,
                           dst_iter_desc->data_type == f16)
             && IMPLICATION(!is_zero_md(bias_desc), bias_desc->data_type == f16);
 
-#if USE_MKL_PACKED_GEMM
     bool is_u8u8u8 = src_layer_dt == u8
             && IMPLICATION(!is_zero_md(src_iter_desc),
                              src_iter_desc->data_type == u8)
@@ -150,15 +152,10 @@ status_t check_data_type_consistency_fwd(const rnn_cell_desc_t *rnn_cell_desc,
             && IMPLICATION(!is_zero_md(bias_desc), bias_desc->data_type == f32);
 
     bool is_inference = prop_kind == prop_kind::forward_inference;
-    bool is_lstm = rnn_cell_desc->cell_kind == mkldnn_vanilla_lstm;
 
-    return (is_f32 || is_f16
-            || ((is_u8u8u8 || is_f32u8f32) && is_lstm && is_inference))
+    return (is_f32 || is_f16 || ((is_u8u8u8 || is_f32u8f32) && is_inference))
             ? success
             : unimplemented;
-#else
-    return (is_f32 || is_f16) ? success : unimplemented;
-#endif
 }
 
 status_t check_dim_consistency(const rnn_cell_desc_t *rnn_cell_desc,
@@ -322,6 +319,79 @@ status_t MKLDNN_API mkldnn_rnn_forward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
     return success;
 }
 
+status_t MKLDNN_API mkldnn_lstm_forward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
+        prop_kind_t prop_kind, const rnn_cell_desc_t *rnn_cell_desc,
+        const rnn_direction_t direction, const memory_desc_t *src_layer_desc,
+        const memory_desc_t *src_iter_desc,
+        const memory_desc_t *weights_layer_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *dst_iter_desc) {
+    bool args_ok = true && rnn_cell_desc != nullptr
+            && rnn_cell_desc->cell_kind == alg_kind::vanilla_lstm;
+    if (!args_ok) return invalid_arguments;
+
+    mkldnn_rnn_desc_t rd;
+    CHECK(mkldnn_rnn_forward_desc_init(&rd, prop_kind, rnn_cell_desc,
+            direction, src_layer_desc, src_iter_desc, weights_layer_desc,
+            weights_iter_desc, bias_desc, dst_layer_desc, dst_iter_desc));
+
+    const memory_desc_t wp_d = copy_maybe_null(weights_peephole_desc);
+    const memory_desc_t wr_d = copy_maybe_null(weights_projection_desc);
+
+    const int L = weights_layer_desc->dims[0];
+    const int D = weights_layer_desc->dims[1];
+    const int DIC = weights_layer_desc->dims[4];
+
+    // peephole weights are (L, D, 3, DIC) and always f32, they are applied
+    // to the cell state which is kept in f32
+    args_ok = IMPLICATION(!is_zero_md(&wp_d), true
+            && wp_d.ndims == 4
+            && wp_d.dims[0] == L && wp_d.dims[1] == D
+            && wp_d.dims[2] == 3 && wp_d.dims[3] == DIC
+            && wp_d.data_type == data_type::f32);
+    if (!args_ok) return invalid_arguments;
+
+    // the projection maps the hidden state to a state of the same size, as
+    // the projected state is stored in src_iter/dst_iter next to the cell
+    // state
+    args_ok = IMPLICATION(!is_zero_md(&wr_d), true
+            && wr_d.ndims == 4
+            && wr_d.dims[0] == L && wr_d.dims[1] == D
+            && wr_d.dims[2] == DIC && wr_d.dims[3] == DIC
+            && wr_d.data_type == weights_iter_desc->data_type);
+    if (!args_ok) return invalid_arguments;
+
+    rd.weights_peephole_desc = wp_d;
+    rd.weights_projection_desc = wr_d;
+
+    *rnn_desc = rd;
+
+    return success;
+}
+
+status_t MKLDNN_API mkldnn_rnn_forward_desc_set_seq_lengths(
+        mkldnn_rnn_desc_t *rnn_desc, const memory_desc_t *seq_lengths_desc) {
+    bool args_ok = true && !any_null(rnn_desc, seq_lengths_desc)
+            && rnn_desc->primitive_kind == primitive_kind::rnn
+            && one_of(rnn_desc->prop_kind, prop_kind::forward_training,
+                    prop_kind::forward_inference);
+    if (!args_ok) return invalid_arguments;
+
+    // one length per minibatch entry
+    const memory_desc_t &sl_d = *seq_lengths_desc;
+    args_ok = true && sl_d.ndims == 1
+            && sl_d.dims[0] == rnn_desc->src_layer_desc.dims[1]
+            && sl_d.data_type == data_type::s32;
+    if (!args_ok) return invalid_arguments;
+
+    rnn_desc->seq_lengths_desc = sl_d;
+
+    return success;
+}
+
 status_t MKLDNN_API mkldnn_rnn_backward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
         prop_kind_t prop_kind, const rnn_cell_desc_t *rnn_cell_desc,
         const rnn_direction_t direction, const memory_desc_t *src_layer_desc,
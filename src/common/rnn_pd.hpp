@@ -45,6 +45,9 @@ struct rnn_pd_t : public primitive_desc_t {
         , bias_md_(desc_.bias_desc)
         , dst_layer_md_(desc_.dst_layer_desc)
         , dst_iter_md_(desc_.dst_iter_desc)
+        , weights_peephole_md_(desc_.weights_peephole_desc)
+        , weights_projection_md_(desc_.weights_projection_desc)
+        , seq_lengths_md_(desc_.seq_lengths_desc)
         , ws_md_()
     {}
 
@@ -64,12 +67,15 @@ struct rnn_pd_t : public primitive_desc_t {
     virtual const memory_desc_t *src_md(int index = 0) const override {
         if (index == 0) return &src_layer_md_;
         if (index == 1 && with_src_iter()) return &src_iter_md_;
+        if (index == 2 && with_seq_lengths()) return &seq_lengths_md_;
         return nullptr;
     }
     virtual const memory_desc_t *weights_md(int index = 0) const override {
         if (index == 0) return &weights_layer_md_;
         if (index == 1) return &weights_iter_md_;
         if (index == 2 && with_bias()) return &bias_md_;
+        if (index == 3 && with_peephole()) return &weights_peephole_md_;
+        if (index == 4 && with_projection()) return &weights_projection_md_;
         return nullptr;
     }
     virtual const memory_desc_t *dst_md(int index = 0) const override {
@@ -117,6 +123,15 @@ struct rnn_pd_t : public primitive_desc_t {
     bool with_dst_iter() const
     { return !memory_desc_wrapper(desc_.dst_iter_desc).is_zero(); }
 
+    bool with_peephole() const
+    { return !memory_desc_wrapper(desc_.weights_peephole_desc).is_zero(); }
+
+    bool with_projection() const
+    { return !memory_desc_wrapper(desc_.weights_projection_desc).is_zero(); }
+
+    bool with_seq_lengths() const
+    { return !memory_desc_wrapper(desc_.seq_lengths_desc).is_zero(); }
+
     mkldnn::impl::alg_kind_t cell_kind() const
     { return desc_.cell_desc.cell_kind; }
     mkldnn::impl::alg_kind_t activation_kind() const
@@ -138,6 +153,9 @@ protected:
     memory_desc_t bias_md_;
     memory_desc_t dst_layer_md_;
     memory_desc_t dst_iter_md_;
+    memory_desc_t weights_peephole_md_;
+    memory_desc_t weights_projection_md_;
+    memory_desc_t seq_lengths_md_;
 
     memory_desc_t ws_md_;
 };
@@ -160,6 +178,9 @@ struct rnn_fwd_pd_t: public rnn_pd_t {
         if (arg == MKLDNN_ARG_SRC_ITER && with_src_iter())
             return arg_usage_t::input;
 
+        if (arg == MKLDNN_ARG_SRC_SEQ_LENGTHS && with_seq_lengths())
+            return arg_usage_t::input;
+
         if (utils::one_of(arg, MKLDNN_ARG_WEIGHTS_LAYER,
                     MKLDNN_ARG_WEIGHTS_ITER))
             return arg_usage_t::input;
@@ -167,6 +188,12 @@ struct rnn_fwd_pd_t: public rnn_pd_t {
         if (arg == MKLDNN_ARG_BIAS && with_bias())
             return arg_usage_t::input;
 
+        if (arg == MKLDNN_ARG_WEIGHTS_PEEPHOLE && with_peephole())
+            return arg_usage_t::input;
+
+        if (arg == MKLDNN_ARG_WEIGHTS_PROJECTION && with_projection())
+            return arg_usage_t::input;
+
         if (arg == MKLDNN_ARG_DST_LAYER)
             return arg_usage_t::output;
 
@@ -180,7 +207,8 @@ struct rnn_fwd_pd_t: public rnn_pd_t {
     }
 
     virtual int n_inputs() const override
-    { return 3 + with_bias() + with_src_iter(); }
+    { return 3 + with_bias() + with_src_iter() + with_peephole()
+        + with_projection() + with_seq_lengths(); }
     virtual int n_outputs() const override
     { return 1 + with_dst_iter() + is_training(); }
 };
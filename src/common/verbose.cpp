@@ -39,6 +39,7 @@
 #include "sum_pd.hpp"
 #include "lrn_pd.hpp"
 #include "gemm_pd.hpp"
+#include "attention_pd.hpp"
 
 /* MKL-DNN CPU ISA info */
 #define ISA_ANY "No instruction set specific optimizations"
@@ -581,6 +582,27 @@ template <typename pd_t> static void init_info_rnn(pd_t *s, char *buffer) {
                 MKLDNN_VERBOSE_DAT_LEN - dat_written, md);
         if (l >= 0) dat_written += l; else clear_buf(dat_str, dat_written);
     }
+    if (s->with_peephole()) { // peephole
+        auto md = s->weights_md(3);
+        DPRINT(dat_str, MKLDNN_VERBOSE_DAT_LEN, dat_written, " wei_peephole_");
+        int l = mkldnn_md2fmt_str(dat_str + dat_written,
+                MKLDNN_VERBOSE_DAT_LEN - dat_written, md);
+        if (l >= 0) dat_written += l; else clear_buf(dat_str, dat_written);
+    }
+    if (s->with_projection()) { // projection
+        auto md = s->weights_md(4);
+        DPRINT(dat_str, MKLDNN_VERBOSE_DAT_LEN, dat_written, " wei_proj_");
+        int l = mkldnn_md2fmt_str(dat_str + dat_written,
+                MKLDNN_VERBOSE_DAT_LEN - dat_written, md);
+        if (l >= 0) dat_written += l; else clear_buf(dat_str, dat_written);
+    }
+    if (s->with_seq_lengths()) { // sequence lengths
+        auto md = s->src_md(2);
+        DPRINT(dat_str, MKLDNN_VERBOSE_DAT_LEN, dat_written, " seq_lengths_");
+        int l = mkldnn_md2fmt_str(dat_str + dat_written,
+                MKLDNN_VERBOSE_DAT_LEN - dat_written, md);
+        if (l >= 0) dat_written += l; else clear_buf(dat_str, dat_written);
+    }
     if (1) { // dst layer
         auto md = s->is_fwd() ? s->dst_md(0) : s->diff_dst_md(0);
         DPRINT(dat_str, MKLDNN_VERBOSE_DAT_LEN, dat_written, "dst_layer_");
@@ -612,6 +634,37 @@ template <typename pd_t> static void init_info_rnn(pd_t *s, char *buffer) {
             aux_str, prb_str);
 }
 
+template <typename pd_t> static void init_info_attention(pd_t *s,
+        char *buffer) {
+    DECL_DAT_AUX_PRB_STRS();
+
+    const char *names[] = {"query_", " key_", " value_"};
+    for (int i = 0; i < 3; i++) {
+        DPRINT(dat_str, MKLDNN_VERBOSE_DAT_LEN, dat_written, "%s", names[i]);
+        int l = mkldnn_md2fmt_str(dat_str + dat_written,
+                MKLDNN_VERBOSE_DAT_LEN - dat_written, s->src_md(i));
+        if (l >= 0) dat_written += l; else clear_buf(dat_str, dat_written);
+    }
+    if (1) { // dst
+        DPRINT(dat_str, MKLDNN_VERBOSE_DAT_LEN, dat_written, " dst_");
+        int l = mkldnn_md2fmt_str(dat_str + dat_written,
+                MKLDNN_VERBOSE_DAT_LEN - dat_written, s->dst_md());
+        if (l >= 0) dat_written += l; else clear_buf(dat_str, dat_written);
+    }
+
+    DPRINT(aux_str, MKLDNN_VERBOSE_AUX_LEN, aux_written,
+            "alg:%s scale:%g key_lengths:%d",
+            mkldnn_alg_kind2str(s->desc()->alg_kind), s->scale(),
+            (int)s->with_key_lengths());
+
+    DPRINT(prb_str, MKLDNN_VERBOSE_PRB_LEN, prb_written,
+            "mb" DFMT "tq" DFMT "tk" DFMT "c" DFMT "cv" DFMT,
+            s->MB(), s->Tq(), s->Tk(), s->C(), s->Cv());
+
+    verbose_templ(buffer, s->kind(), s->name(), s->desc()->prop_kind, dat_str,
+            aux_str, prb_str);
+}
+
 #undef DPRINT
 
 #else // !defined(DISABLE_VERBOSE)
@@ -621,6 +674,7 @@ template <typename pd_t> static void init_info_rnn(pd_t *s, char *buffer) {
     static void CONCAT2(init_info_, name)(pd_t *s, char *buffer) \
     { UNUSED(s); UNUSED(buffer); }
 
+DEFINE_STUB(attention);
 DEFINE_STUB(bnorm);
 DEFINE_STUB(conv);
 DEFINE_STUB(eltwise);
@@ -637,6 +691,8 @@ DEFINE_STUB(shuffle);
 #endif // !defined(DISABLE_VERBOSE)
 }
 
+void init_info(attention_pd_t *s, char *b)
+{ init_info_attention(s, b); }
 void init_info(batch_normalization_pd_t *s, char *b)
 { init_info_bnorm(s, b); }
 void init_info(concat_pd_t *s, char *b)
@@ -42,6 +42,7 @@ const char *get_isa_info();
 #define MKLDNN_VERBOSE_BUF_LEN 1
 #endif
 
+void init_info(attention_pd_t *s, char *buffer);
 void init_info(batch_normalization_pd_t *s, char *buffer);
 void init_info(concat_pd_t *s, char *buffer);
 void init_info(convolution_pd_t *s, char *buffer);
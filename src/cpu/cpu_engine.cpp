@@ -25,11 +25,13 @@
 #include "memory.hpp"
 
 #include "cpu/rnn/ref_rnn.hpp"
+#include "cpu/ref_attention.hpp"
 
 #include "cpu/jit_avx512_core_x8s8s32x_1x1_convolution.hpp"
 #include "cpu/jit_avx512_common_1x1_convolution.hpp"
 #include "cpu/jit_avx512_core_fp32_wino_conv_4x3.hpp"
 #include "cpu/jit_avx512_common_convolution_winograd.hpp"
+#include "cpu/jit_avx2_convolution_winograd.hpp"
 #include "cpu/jit_avx512_core_x8s8s32x_convolution.hpp"
 #include "cpu/jit_avx512_common_convolution.hpp"
 #include "cpu/jit_avx2_1x1_convolution.hpp"
@@ -37,6 +39,7 @@
 #include "cpu/jit_avx2_convolution.hpp"
 #include "cpu/jit_sse41_convolution.hpp"
 #include "cpu/gemm_convolution.hpp"
+#include "cpu/fft_convolution.hpp"
 #include "cpu/gemm_x8s8s32x_convolution.hpp"
 #include "cpu/ref_convolution.hpp"
 #include "cpu/jit_avx512_core_x8s8s32x_deconvolution.hpp"
@@ -91,6 +94,8 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_rnn_fwd_f32_t),
     INSTANCE(ref_rnn_fwd_u8s8_t),
     INSTANCE(ref_rnn_bwd_f32_t),
+    /* attention */
+    INSTANCE(ref_attention_fwd_t),
     /* conv */
     INSTANCE(jit_avx512_common_dw_convolution_fwd_t),
     INSTANCE(jit_avx512_common_dw_convolution_bwd_data_t),
@@ -105,6 +110,7 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_avx512_common_convolution_winograd_fwd_t),
     INSTANCE(jit_avx512_common_convolution_winograd_bwd_data_t),
     INSTANCE(jit_avx512_common_convolution_winograd_bwd_weights_t),
+    INSTANCE(jit_avx2_convolution_winograd_fwd_t),
     INSTANCE(jit_avx512_common_convolution_fwd_t<f32>),
     INSTANCE(jit_avx512_common_convolution_bwd_data_t<f32>),
     INSTANCE(jit_avx512_common_convolution_bwd_weights_t<f32>),
@@ -122,6 +128,7 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_avx2_convolution_bwd_data_t),
     INSTANCE(jit_avx2_convolution_bwd_weights_t),
     INSTANCE(jit_sse41_convolution_fwd_t),
+    INSTANCE(fft_convolution_fwd_t),
     INSTANCE(gemm_convolution_fwd_t),
     INSTANCE(gemm_convolution_bwd_data_t),
     INSTANCE(gemm_convolution_bwd_weights_t),
@@ -0,0 +1,538 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "gemm/gemm.hpp"
+
+#include "fft_convolution.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+
+namespace {
+
+const int simd_w = 16; // channels transformed at once
+
+/* In-place radix-2 FFT of n vectors of simd_w complex values. The real and
+ * imaginary parts of the k-th vector start at re + k * stride and
+ * im + k * stride, exp(-2 pi i j / (n * tw_step)) is tw[j * tw_step]. */
+void fft(float *re, float *im, int n, int stride, const float *tw_re,
+        const float *tw_im, int tw_step, bool inverse) {
+    for (int i = 1, j = 0; i < n; ++i) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i >= j) continue;
+        float *ar = re + i * stride, *ai = im + i * stride;
+        float *br = re + j * stride, *bi = im + j * stride;
+        PRAGMA_OMP_SIMD()
+        for (int l = 0; l < simd_w; ++l) {
+            nstl::swap(ar[l], br[l]);
+            nstl::swap(ai[l], bi[l]);
+        }
+    }
+
+    for (int len = 2; len <= n; len <<= 1) {
+        const int half = len / 2;
+        const int step = n / len * tw_step;
+        for (int j = 0; j < half; ++j) {
+            const float wr = tw_re[j * step];
+            const float wi = inverse ? -tw_im[j * step] : tw_im[j * step];
+            for (int i = j; i < n; i += len) {
+                float *ur = re + i * stride, *ui = im + i * stride;
+                float *vr = ur + half * stride, *vi = ui + half * stride;
+                PRAGMA_OMP_SIMD()
+                for (int l = 0; l < simd_w; ++l) {
+                    const float tr = vr[l] * wr - vi[l] * wi;
+                    const float ti = vr[l] * wi + vi[l] * wr;
+                    vr[l] = ur[l] - tr;
+                    vi[l] = ui[l] - ti;
+                    ur[l] += tr;
+                    ui[l] += ti;
+                }
+            }
+        }
+    }
+}
+
+/* Real FFT of a row of n vectors: the even and odd samples are packed as the
+ * real and imaginary parts of a complex FFT of length n / 2, which is then
+ * split into the n / 2 + 1 non-redundant frequencies
+ *   X[k] = E + W^k O and X[n / 2 - k] = conj(E - W^k O). */
+void rfft_row(const float *r, float *re, float *im, int n,
+        const float *tw_re, const float *tw_im) {
+    const int h = n / 2;
+    for (int j = 0; j < h; ++j) {
+        PRAGMA_OMP_SIMD()
+        for (int l = 0; l < simd_w; ++l) {
+            re[j * simd_w + l] = r[2 * j * simd_w + l];
+            im[j * simd_w + l] = r[(2 * j + 1) * simd_w + l];
+        }
+    }
+
+    fft(re, im, h, simd_w, tw_re, tw_im, 2, false);
+
+    float *hr = re + h * simd_w, *hi = im + h * simd_w;
+    PRAGMA_OMP_SIMD()
+    for (int l = 0; l < simd_w; ++l) {
+        const float a = re[l], b = im[l];
+        re[l] = a + b;
+        im[l] = 0.f;
+        hr[l] = a - b;
+        hi[l] = 0.f;
+    }
+
+    for (int k = 1; k <= h / 2; ++k) {
+        const float wr = tw_re[k], wi = tw_im[k];
+        float *kr = re + k * simd_w, *ki = im + k * simd_w;
+        float *mr = re + (h - k) * simd_w, *mi = im + (h - k) * simd_w;
+        PRAGMA_OMP_SIMD()
+        for (int l = 0; l < simd_w; ++l) {
+            const float er = .5f * (kr[l] + mr[l]);
+            const float ei = .5f * (ki[l] - mi[l]);
+            const float or_ = .5f * (ki[l] + mi[l]);
+            const float oi = .5f * (mr[l] - kr[l]);
+            const float tr = wr * or_ - wi * oi;
+            const float ti = wr * oi + wi * or_;
+            kr[l] = er + tr;
+            ki[l] = ei + ti;
+            mr[l] = er - tr;
+            mi[l] = ti - ei;
+        }
+    }
+}
+
+/* Inverse of rfft_row scaled by n */
+void irfft_row(float *re, float *im, float *r, int n,
+        const float *tw_re, const float *tw_im) {
+    const int h = n / 2;
+
+    float *hr = re + h * simd_w, *hi = im + h * simd_w;
+    PRAGMA_OMP_SIMD()
+    for (int l = 0; l < simd_w; ++l) {
+        const float er = re[l] + hr[l], ei = im[l] - hi[l];
+        const float dr = re[l] - hr[l], di = im[l] + hi[l];
+        re[l] = er - di;
+        im[l] = ei + dr;
+    }
+
+    for (int k = 1; k <= h / 2; ++k) {
+        const float wr = tw_re[k], wi = tw_im[k];
+        float *kr = re + k * simd_w, *ki = im + k * simd_w;
+        float *mr = re + (h - k) * simd_w, *mi = im + (h - k) * simd_w;
+        PRAGMA_OMP_SIMD()
+        for (int l = 0; l < simd_w; ++l) {
+            const float er = kr[l] + mr[l], ei = ki[l] - mi[l];
+            const float dr = kr[l] - mr[l], di = ki[l] + mi[l];
+            const float or_ = dr * wr + di * wi;
+            const float oi = di * wr - dr * wi;
+            kr[l] = er - oi;
+            ki[l] = ei + or_;
+            mr[l] = er + oi;
+            mi[l] = or_ - ei;
+        }
+    }
+
+    fft(re, im, h, simd_w, tw_re, tw_im, 2, true);
+
+    for (int j = 0; j < h; ++j) {
+        PRAGMA_OMP_SIMD()
+        for (int l = 0; l < simd_w; ++l) {
+            r[2 * j * simd_w + l] = re[j * simd_w + l];
+            r[(2 * j + 1) * simd_w + l] = im[j * simd_w + l];
+        }
+    }
+}
+
+}
+
+status_t fft_convolution_fwd_t::pd_t::init_conf() {
+    auto &jcp = jcp_;
+    const convolution_desc_t &cd = *desc();
+
+    jcp.prop_kind = cd.prop_kind;
+
+    jcp.mb = MB();
+    jcp.ngroups = G();
+    jcp.ic = IC() / jcp.ngroups;
+    jcp.oc = OC() / jcp.ngroups;
+    jcp.ih = IH();
+    jcp.iw = IW();
+    jcp.oh = OH();
+    jcp.ow = OW();
+    jcp.kh = KH();
+    jcp.kw = KW();
+    jcp.t_pad = padT();
+    jcp.l_pad = padL();
+
+    bool ok = true
+        && KSH() == 1 && KSW() == 1
+        && (ndims() == 3 || KDH() == 0) && KDW() == 0
+        && jcp.kh <= max_nh && jcp.kw <= max_nw;
+    if (!ok) return status::unimplemented;
+
+    const auto &p = attr()->post_ops_;
+    auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
+    auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
+    switch (p.len_) {
+    case 0: ok = true; break;
+    case 1: ok = is_eltwise(0) || is_sum(0); break;
+    case 2: ok = is_sum(0) && is_eltwise(1); break;
+    default: ok = false;
+    }
+    if (!ok) return status::unimplemented;
+
+    jcp.with_bias = with_bias();
+    const int sum_ind = p.find(primitive_kind::sum);
+    jcp.with_sum = sum_ind != -1;
+    jcp.sum_scale = jcp.with_sum ? p.entry_[sum_ind].sum.scale : 1.f;
+    const int eltwise_ind = p.find(primitive_kind::eltwise);
+    jcp.with_eltwise = eltwise_ind != -1;
+    if (jcp.with_eltwise)
+        jcp.eltwise = p.entry_[eltwise_ind].eltwise;
+
+    /* The fft sizes are powers of two chosen by the flop count of the
+     * transforms (~2.5 n log2 n for a real fft of size n) and of the complex
+     * products (8 flops per multiply-add) over all tiles. Sizes beyond the
+     * padded image only add work. */
+    auto pow2_ge = [](int v) { int n = 1; while (n < v) n *= 2; return n; };
+    auto flops = [&](int nh, int nw) {
+        const double tiles = (double)div_up(jcp.oh, nh - jcp.kh + 1)
+            * div_up(jcp.ow, nw - jcp.kw + 1);
+        const double fft = 2.5 * nh * nw * log2((double)nh * nw)
+            * (jcp.ic + jcp.oc);
+        const double prod = 8. * nh * (nw / 2 + 1) * jcp.ic * jcp.oc;
+        return tiles * (fft + prod);
+    };
+
+    const int nh_min = pow2_ge(jcp.kh);
+    const int nh_max = ndims() == 3 ? 1
+        : nstl::max(nh_min, nstl::min((int)max_nh,
+                    pow2_ge(jcp.oh + jcp.kh - 1)));
+    const int nw_min = nstl::max(4, pow2_ge(jcp.kw));
+    const int nw_max = nstl::max(nw_min, nstl::min(ndims() == 3
+                ? (int)max_nw : (int)max_nh, pow2_ge(jcp.ow + jcp.kw - 1)));
+    if (nh_min > max_nh || nw_min > max_nw) return status::unimplemented;
+
+    jcp.nh = nh_min;
+    jcp.nw = nw_min;
+    for (int nh = nh_min; nh <= nh_max; nh *= 2)
+    for (int nw = nw_min; nw <= nw_max; nw *= 2)
+        if (flops(nh, nw) < flops(jcp.nh, jcp.nw)) {
+            jcp.nh = nh;
+            jcp.nw = nw;
+        }
+
+    jcp.tile_h = jcp.nh - jcp.kh + 1;
+    jcp.tile_w = jcp.nw - jcp.kw + 1;
+    jcp.nfreq = jcp.nh * (jcp.nw / 2 + 1);
+
+    jcp.tiles_h = div_up(jcp.oh, jcp.tile_h);
+    jcp.tiles_w = div_up(jcp.ow, jcp.tile_w);
+    jcp.ntiles = jcp.mb * jcp.tiles_h * jcp.tiles_w;
+
+    /* every tile block makes one pass over the transformed weights */
+    jcp.nthr = mkldnn_get_max_threads();
+    const size_t max_thr_wsp = 8 * 1024 * 1024;
+    const size_t tile_wsp
+        = sizeof(float) * 2 * jcp.nfreq * (jcp.ic + jcp.oc);
+    jcp.tile_block = nstl::min(64, div_up(jcp.ntiles, jcp.nthr));
+    while (jcp.tile_block > 4 && jcp.tile_block * tile_wsp > max_thr_wsp)
+        jcp.tile_block /= 2;
+    jcp.nb_tile_block = div_up(jcp.ntiles, jcp.tile_block);
+
+    return status::success;
+}
+
+void fft_convolution_fwd_t::pd_t::init_scratchpad() {
+    auto scratchpad = scratchpad_registry().registrar();
+    const auto &jcp = jcp_;
+    const size_t nf2 = 2 * jcp.nfreq;
+    const size_t buf_sz = simd_w * (jcp.nh * jcp.nw + nf2);
+
+    scratchpad.book(key_conv_fft_U, sizeof(float) * nf2 * jcp.ic * jcp.oc);
+    scratchpad.book(key_conv_fft_V,
+            sizeof(float) * jcp.nthr * nf2 * jcp.tile_block * jcp.ic);
+    scratchpad.book(key_conv_fft_M,
+            sizeof(float) * jcp.nthr * nf2 * jcp.tile_block * jcp.oc);
+    scratchpad.book(key_conv_fft_buf, sizeof(float) * jcp.nthr * buf_sz);
+}
+
+fft_convolution_fwd_t::fft_convolution_fwd_t(const pd_t *apd)
+    : cpu_primitive_t(apd, true)
+    , eltwise_(nullptr)
+{
+    const auto &jcp = pd()->jcp_;
+    const double pi = 3.14159265358979323846;
+
+    for (int k = 0; k < jcp.nh / 2; ++k) {
+        tw_h_[0][k] = (float)cos(2. * pi * k / jcp.nh);
+        tw_h_[1][k] = (float)-sin(2. * pi * k / jcp.nh);
+    }
+    for (int k = 0; k <= jcp.nw / 2; ++k) {
+        tw_w_[0][k] = (float)cos(2. * pi * k / jcp.nw);
+        tw_w_[1][k] = (float)-sin(2. * pi * k / jcp.nw);
+    }
+
+    if (jcp.with_eltwise)
+        eltwise_ = new ref_eltwise_scalar_fwd_t(jcp.eltwise);
+}
+
+/* r[nh][nw][simd_w] -> re, im[nh][nw / 2 + 1][simd_w] */
+void fft_convolution_fwd_t::rfft2d(const float *r, float *re, float *im)
+        const {
+    const auto &jcp = pd()->jcp_;
+    const int nwc = jcp.nw / 2 + 1;
+
+    for (int y = 0; y < jcp.nh; ++y)
+        rfft_row(r + y * jcp.nw * simd_w, re + y * nwc * simd_w,
+                im + y * nwc * simd_w, jcp.nw, tw_w_[0], tw_w_[1]);
+
+    if (jcp.nh > 1)
+        for (int x = 0; x < nwc; ++x)
+            fft(re + x * simd_w, im + x * simd_w, jcp.nh, nwc * simd_w,
+                    tw_h_[0], tw_h_[1], 1, false);
+}
+
+/* Inverse of rfft2d scaled by nh * nw, re and im are overwritten */
+void fft_convolution_fwd_t::irfft2d(float *re, float *im, float *r) const {
+    const auto &jcp = pd()->jcp_;
+    const int nwc = jcp.nw / 2 + 1;
+
+    if (jcp.nh > 1)
+        for (int x = 0; x < nwc; ++x)
+            fft(re + x * simd_w, im + x * simd_w, jcp.nh, nwc * simd_w,
+                    tw_h_[0], tw_h_[1], 1, true);
+
+    for (int y = 0; y < jcp.nh; ++y)
+        irfft_row(re + y * nwc * simd_w, im + y * nwc * simd_w,
+                r + y * jcp.nw * simd_w, jcp.nw, tw_w_[0], tw_w_[1]);
+}
+
+void fft_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
+    auto weights = CTX_IN_MEM(const data_t *, MKLDNN_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const data_t *, MKLDNN_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DST);
+
+    const auto &jcp = pd()->jcp_;
+    auto scratchpad = this->scratchpad(ctx);
+
+    const int nh = jcp.nh, nw = jcp.nw, nf = jcp.nfreq;
+    const size_t U_stride = (size_t)jcp.ic * jcp.oc;
+    const size_t V_stride = (size_t)jcp.tile_block * jcp.ic;
+    const size_t M_stride = (size_t)jcp.tile_block * jcp.oc;
+    const size_t buf_sz = simd_w * (nh * nw + 2 * nf);
+
+    /* planes of real parts followed by planes of imaginary parts:
+     * U[nf][ic][oc], V[nf][tile][ic] and M[nf][tile][oc] */
+    float *U = scratchpad.get<float>(key_conv_fft_U);
+    float *V = scratchpad.get<float>(key_conv_fft_V);
+    float *M = scratchpad.get<float>(key_conv_fft_M);
+    float *buf = scratchpad.get<float>(key_conv_fft_buf);
+
+    const int nb_oc = div_up(jcp.oc, simd_w);
+    const int nb_ic = div_up(jcp.ic, simd_w);
+
+    const size_t src_sp = (size_t)jcp.ih * jcp.iw;
+    const size_t dst_sp = (size_t)jcp.oh * jcp.ow;
+    const size_t src_mb_stride = jcp.ngroups * jcp.ic * src_sp;
+    const size_t dst_mb_stride = jcp.ngroups * jcp.oc * dst_sp;
+
+    for (int g = 0; g < jcp.ngroups; ++g) {
+        const data_t *src_g = src + g * jcp.ic * src_sp;
+        const data_t *wei_g
+            = weights + (size_t)g * jcp.oc * jcp.ic * jcp.kh * jcp.kw;
+        const data_t *bia_g = jcp.with_bias ? bias + g * jcp.oc : nullptr;
+        data_t *dst_g = dst + g * jcp.oc * dst_sp;
+
+        /* U = conj(fft(w)) / (nh * nw), so that the inverse transform of the
+         * products is the correlation. A vector holds simd_w oc of one ic. */
+        parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+            float *r = buf + ithr * buf_sz;
+            float *re = r + nh * nw * simd_w, *im = re + nf * simd_w;
+            const float scale = 1.f / (nh * nw);
+
+            int start{0}, end{0};
+            balance211(nb_oc * jcp.ic, nthr, ithr, start, end);
+            for (int iwork = start; iwork < end; ++iwork) {
+                const int ocb = iwork / jcp.ic, ic = iwork % jcp.ic;
+                const int oc_s = ocb * simd_w;
+                const int noc = nstl::min(simd_w, jcp.oc - oc_s);
+
+                array_set(r, 0.f, nh * nw * simd_w);
+                for (int l = 0; l < noc; ++l) {
+                    const data_t *w = wei_g
+                        + ((size_t)(oc_s + l) * jcp.ic + ic) * jcp.kh * jcp.kw;
+                    for (int y = 0; y < jcp.kh; ++y)
+                    for (int x = 0; x < jcp.kw; ++x)
+                        r[(y * nw + x) * simd_w + l] = w[y * jcp.kw + x];
+                }
+
+                rfft2d(r, re, im);
+
+                for (int f = 0; f < nf; ++f) {
+                    float *u = U + f * U_stride + ic * jcp.oc + oc_s;
+                    for (int l = 0; l < noc; ++l) {
+                        u[l] = scale * re[f * simd_w + l];
+                        u[nf * U_stride + l] = -scale * im[f * simd_w + l];
+                    }
+                }
+            }
+        });
+
+        auto tile_coords = [&](int tile, int &n, int &th, int &tw) {
+            tw = tile % jcp.tiles_w;
+            th = (tile / jcp.tiles_w) % jcp.tiles_h;
+            n = tile / (jcp.tiles_w * jcp.tiles_h);
+        };
+
+        parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+            int start{0}, end{0};
+            balance211(jcp.nb_tile_block, nthr, ithr, start, end);
+
+            float *V_re = V + (size_t)ithr * 2 * nf * V_stride;
+            float *V_im = V_re + nf * V_stride;
+            float *M_re = M + (size_t)ithr * 2 * nf * M_stride;
+            float *M_im = M_re + nf * M_stride;
+            float *r = buf + ithr * buf_sz;
+            float *re = r + nh * nw * simd_w, *im = re + nf * simd_w;
+
+            for (int tb = start; tb < end; ++tb) {
+                const int tile_start = tb * jcp.tile_block;
+                const int nt
+                    = nstl::min(jcp.tile_block, jcp.ntiles - tile_start);
+
+                /* V = fft(d) of the nh x nw input patch of each tile */
+                for (int t = 0; t < nt; ++t) {
+                    int n, th, tw;
+                    tile_coords(tile_start + t, n, th, tw);
+                    const int ih_s = th * jcp.tile_h - jcp.t_pad;
+                    const int iw_s = tw * jcp.tile_w - jcp.l_pad;
+                    const int y_s = nstl::max(0, -ih_s);
+                    const int y_e = nstl::min(nh, jcp.ih - ih_s);
+                    const int x_s = nstl::max(0, -iw_s);
+                    const int x_e = nstl::min(nw, jcp.iw - iw_s);
+
+                    for (int icb = 0; icb < nb_ic; ++icb) {
+                        const int ic_s = icb * simd_w;
+                        const int nic = nstl::min(simd_w, jcp.ic - ic_s);
+
+                        array_set(r, 0.f, nh * nw * simd_w);
+                        for (int l = 0; l < nic; ++l) {
+                            const data_t *s = src_g + n * src_mb_stride
+                                + (ic_s + l) * src_sp;
+                            for (int y = y_s; y < y_e; ++y)
+                            for (int x = x_s; x < x_e; ++x)
+                                r[(y * nw + x) * simd_w + l]
+                                    = s[(ih_s + y) * jcp.iw + iw_s + x];
+                        }
+
+                        rfft2d(r, re, im);
+
+                        for (int f = 0; f < nf; ++f) {
+                            const size_t off = f * V_stride + t * jcp.ic + ic_s;
+                            for (int l = 0; l < nic; ++l) {
+                                V_re[off + l] = re[f * simd_w + l];
+                                V_im[off + l] = im[f * simd_w + l];
+                            }
+                        }
+                    }
+                }
+
+                /* M = V U for each frequency as four real products */
+                const float one = 1.f, zero = 0.f, minus_one = -1.f;
+                for (int f = 0; f < nf; ++f) {
+                    const float *U_re = U + f * U_stride;
+                    const float *U_im = U_re + nf * U_stride;
+                    const float *v_re = V_re + f * V_stride;
+                    const float *v_im = V_im + f * V_stride;
+                    float *m_re = M_re + f * M_stride;
+                    float *m_im = M_im + f * M_stride;
+                    extended_sgemm("N", "N", &jcp.oc, &nt, &jcp.ic, &one,
+                            U_re, &jcp.oc, v_re, &jcp.ic, &zero, m_re, &jcp.oc);
+                    extended_sgemm("N", "N", &jcp.oc, &nt, &jcp.ic, &minus_one,
+                            U_im, &jcp.oc, v_im, &jcp.ic, &one, m_re, &jcp.oc);
+                    extended_sgemm("N", "N", &jcp.oc, &nt, &jcp.ic, &one,
+                            U_im, &jcp.oc, v_re, &jcp.ic, &zero, m_im, &jcp.oc);
+                    extended_sgemm("N", "N", &jcp.oc, &nt, &jcp.ic, &one,
+                            U_re, &jcp.oc, v_im, &jcp.ic, &one, m_im, &jcp.oc);
+                }
+
+                /* Y = ifft(M), the first tile_h x tile_w points are the valid
+                 * part of the correlation */
+                for (int t = 0; t < nt; ++t) {
+                    int n, th, tw;
+                    tile_coords(tile_start + t, n, th, tw);
+                    const int oh_s = th * jcp.tile_h, ow_s = tw * jcp.tile_w;
+                    const int h = nstl::min(jcp.tile_h, jcp.oh - oh_s);
+                    const int w = nstl::min(jcp.tile_w, jcp.ow - ow_s);
+
+                    for (int ocb = 0; ocb < nb_oc; ++ocb) {
+                        const int oc_s = ocb * simd_w;
+                        const int noc = nstl::min(simd_w, jcp.oc - oc_s);
+
+                        for (int f = 0; f < nf; ++f) {
+                            const size_t off = f * M_stride + t * jcp.oc + oc_s;
+                            for (int l = 0; l < noc; ++l) {
+                                re[f * simd_w + l] = M_re[off + l];
+                                im[f * simd_w + l] = M_im[off + l];
+                            }
+                            for (int l = noc; l < simd_w; ++l) {
+                                re[f * simd_w + l] = 0.f;
+                                im[f * simd_w + l] = 0.f;
+                            }
+                        }
+
+                        irfft2d(re, im, r);
+
+                        for (int l = 0; l < noc; ++l) {
+                            const float b
+                                = jcp.with_bias ? bia_g[oc_s + l] : 0.f;
+                            data_t *d = dst_g + n * dst_mb_stride
+                                + (oc_s + l) * dst_sp + oh_s * jcp.ow + ow_s;
+                            for (int y = 0; y < h; ++y)
+                            for (int x = 0; x < w; ++x) {
+                                float v = r[(y * nw + x) * simd_w + l] + b;
+                                if (jcp.with_sum)
+                                    v += jcp.sum_scale * d[y * jcp.ow + x];
+                                if (eltwise_)
+                                    v = eltwise_->compute_scalar(v);
+                                d[y * jcp.ow + x] = v;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
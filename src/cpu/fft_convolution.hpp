@@ -0,0 +1,126 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_FFT_CONVOLUTION_HPP
+#define CPU_FFT_CONVOLUTION_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "mkldnn_thread.hpp"
+#include "utils.hpp"
+
+#include "cpu_convolution_pd.hpp"
+#include "cpu_primitive.hpp"
+#include "ref_eltwise.hpp"
+
+#include "jit_primitive_conf.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* FFT forward convolution for 1D and 2D problems with large kernels.
+ *
+ * The output is split into tiles of (nh - kh + 1) x (nw - kw + 1) points.
+ * The nh x nw input patch of every tile and the zero padded weights are
+ * transformed with real to complex FFTs, multiplied point by point with one
+ * complex product of [tile x ic] by [ic x oc] matrices per frequency (four
+ * sgemm calls) and transformed back; the valid part of the circular
+ * correlation is the tile of the output (overlap-save). */
+struct fft_convolution_fwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        pd_t(engine_t *engine, const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const typename pd_t::base_class *hint_fwd_pd)
+            : cpu_convolution_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T("fft:any", fft_convolution_fwd_t);
+
+        status_t init() {
+            bool ok = true
+                && is_fwd()
+                && desc()->alg_kind == alg_kind::convolution_fft
+                && expect_data_types(data_type::f32, data_type::f32,
+                        data_type::f32, data_type::f32, data_type::f32)
+                && !has_zero_dim_memory()
+                && utils::one_of(ndims(), 3, 4)
+                && set_default_formats_common(dat_tag(), wei_tag(), dat_tag())
+                && memory_desc_matches_tag(*src_md(), dat_tag())
+                && memory_desc_matches_tag(*dst_md(), dat_tag())
+                && memory_desc_matches_tag(*weights_md(), wei_tag());
+            if (!ok) return status::unimplemented;
+
+            status_t status = init_conf();
+            if (status != status::success) return status;
+
+            init_scratchpad();
+
+            return status::success;
+        }
+
+        jit_fft_conv_conf_t jcp_;
+
+    protected:
+        status_t init_conf();
+        void init_scratchpad();
+
+        format_tag_t dat_tag() const {
+            using namespace format_tag;
+            return ndims() == 3 ? ncw : nchw;
+        }
+
+        format_tag_t wei_tag() const {
+            using namespace format_tag;
+            return with_groups()
+                ? (ndims() == 3 ? goiw : goihw)
+                : (ndims() == 3 ? oiw : oihw);
+        }
+    };
+
+    fft_convolution_fwd_t(const pd_t *apd);
+    ~fft_convolution_fwd_t() { delete eltwise_; }
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override {
+        execute_forward(ctx);
+        return status::success;
+    }
+
+    enum { max_nh = 64, max_nw = 512 };
+
+private:
+    void execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    void rfft2d(const float *r, float *re, float *im) const;
+    void irfft2d(float *re, float *im, float *r) const;
+
+    /* exp(-2 pi i k / nh) and exp(-2 pi i k / nw) */
+    float tw_h_[2][max_nh / 2];
+    float tw_w_[2][max_nw / 2 + 1];
+
+    ref_eltwise_scalar_fwd_t *eltwise_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
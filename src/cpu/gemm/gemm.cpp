@@ -229,9 +229,9 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
         // mkldnn_gemm_s8s8s32 doesn't support non-zero ao and bo
         if ((mayiuse(avx512_core) || mayiuse(avx512_core_vnni))
                 && *ao == 0 && *bo == 0) {
-            status = simple_gemm_s8s8s32(transa, transb, offsetc, M,
+            status = gemm_driver(transa, transb, offsetc, M,
                     N, K, alpha, A, LDA, ao, (int8_t *)B, LDB, bo, beta,
-                    C, LDC, co);
+                    C, LDC, co, false);
         } else {
             status = ref_gemm_s8x8s32(transa, transb, offsetc, M, N, K,
                     alpha, A, LDA, ao, B, LDB, bo, beta, C, LDC, co);
@@ -25,12 +25,15 @@
 #include "f32/jit_avx512_common_gemm_f32.hpp"
 #include "f32/jit_avx_gemm_f32.hpp"
 #include "gemm_info.hpp"
+#include "gemm_numa.hpp"
+#include "gemm_tuning.hpp"
 #include "jit_generator.hpp"
 #include "mkldnn_traits.hpp"
 #include "mkldnn_types.h"
 #include "nstl.hpp"
 #include "s8x8s32/gemv.hpp"
 #include "utils.hpp"
+#include "verbose.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -40,6 +43,7 @@ typedef struct {
     int nthrs_m, nthrs_n, nthrs_k;
     int partition;
     int copy_type;
+    int ngroups; // Number of NUMA groups sharing packed A panels
 } blas_thread_t;
 
 template <typename c_type>
@@ -223,6 +227,23 @@ static inline void *align(void *ptr, size_t alignment) {
     return (void *) utils::rnd_up((uintptr_t) ptr, alignment);
 }
 
+// Move a packed s8 block of B to the u8 domain: b + 128 == b ^ 0x80. The
+// block is hot in cache right after the copy, so this replaces the extra
+// pass over the whole B matrix of the shift-and-compensate approach.
+template <typename b_type>
+static inline void shift_packed_b(const dim_t k, const dim_t n,
+        b_type *bufferB) {
+    if (data_traits<b_type>::data_type != data_type::s8)
+        return;
+
+    // Copy kernels pad the k-dimension to a multiple of 4 with zeros.
+    const dim_t nelems = utils::rnd_up(k, 4) * n;
+    uint8_t *p = (uint8_t *) bufferB;
+    PRAGMA_OMP_SIMD()
+    for (dim_t i = 0; i < nelems; i++)
+        p[i] ^= 0x80;
+}
+
 template <typename scale_t, typename mat_t>
 void scale_matrix(dim_t m, dim_t n, scale_t alpha, mat_t * __restrict p_mat,
         dim_t ld) {
@@ -238,14 +259,13 @@ void scale_matrix(dim_t m, dim_t n, scale_t alpha, mat_t * __restrict p_mat,
 
 template <typename a_type, typename b_type, typename c_type>
 static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
-        const dim_t k, const a_type *a, const b_type *b, c_type *c,
-        const c_type *co, const gemm_info_t<a_type, b_type, c_type> *arg) {
+        const dim_t k, const a_type *a, const b_type *b, float beta,
+        c_type *c, const dim_t ldc, const c_type *co,
+        const gemm_info_t<a_type, b_type, c_type> *arg) {
     dim_t lda = arg->lda;
     dim_t ldb = arg->ldb;
-    dim_t ldc = arg->ldc;
 
     float alpha = *arg->alpha;
-    float beta = *arg->beta;
 
     if (m <= 0 || n <= 0) {
         return mkldnn_success;
@@ -382,6 +402,7 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
                  */
                 arg->copyB(&sizeK, &sizeN, b_block, &ldb, &one, bufferB, NULL,
                         NULL, b_col_sum);
+                shift_packed_b(sizeK, sizeN, bufferB);
 
                 dim_t sizeUM = 0;
                 for (dim_t Um = 0; Um < sizeM; Um += sizeUM) {
@@ -532,6 +553,7 @@ static mkldnn_status_t kernel_driver_parallel_acopiedbcopy(const dim_t m,
          */
         arg->copyB(&k, &sizeN, b_block, &ldb, &one, bufferB, NULL, NULL,
                 b_col_sum);
+        shift_packed_b(k, sizeN, bufferB);
 
         dim_t co_stride = 0;
         if (isInteger) {
@@ -664,7 +686,8 @@ static inline int nocopy_checker(const int nthr, const int transa,
 #define M2D_MIN 384
 template <typename a_type, typename b_type, typename c_type>
 static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
-        const gemm_info_t<a_type, b_type, c_type> *arg) {
+        const gemm_info_t<a_type, b_type, c_type> *arg,
+        const gemm_tuning_hint_t &hint) {
 
     int nthrs = *p_nthrs;
     int transa = arg->transa;
@@ -680,11 +703,14 @@ static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
     thread_info->nthrs_n = 0;
     thread_info->nthrs_k = 0;
     thread_info->copy_type = COPY_NONE; // By default don't do parallel copy.
+    thread_info->ngroups = 1;
 
     bool isInteger = data_traits<a_type>::data_type == data_type::s8;
 
-    if (!isInteger &&
-            nocopy_checker(nthrs, transa, transb, m, n, k, lda, ldb, ldc)) {
+    int nocopy = hint.nocopy >= 0 ? hint.nocopy
+        : nocopy_checker(nthrs, transa, transb, m, n, k, lda, ldb, ldc);
+
+    if (!isInteger && nocopy) {
         thread_info->copy_type = NO_COPY;
         int nthrs_m = 0;
         int nthrs_n = 0;
@@ -712,6 +738,30 @@ static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
         *p_nthrs = nthrs_m * nthrs_n * nthrs_k;
     }
 
+    // Use the partitioning measured by the autotuner. 2D partitioning is
+    // left to the heuristic below as it needs the thread grid.
+    if (hint.partition >= 0 && hint.partition != PARTITION_2D
+            && IMPLICATION(hint.partition == PARTITION_1D_K, !isInteger)
+            && thread_info->copy_type == COPY_NONE) {
+        thread_info->partition = hint.partition;
+        if (hint.partition == PARTITION_1D_K)
+            thread_info->nthrs_k = nthrs;
+        return;
+    }
+
+    // Partition along k if m and n are too small to give every thread a full
+    // register tile and k is large enough to amortize the reduction of the
+    // partial results.
+    if (!isInteger && thread_info->copy_type == COPY_NONE) {
+        dim_t tiles_mn = nstl::max(utils::div_up(m, arg->um),
+                utils::div_up(n, arg->un));
+        if (2 * tiles_mn <= nthrs && k >= nthrs * arg->bk_traditional) {
+            thread_info->nthrs_k = nthrs;
+            thread_info->partition = PARTITION_1D_K;
+            return;
+        }
+    }
+
     // TODO Check if we can use dynamic scheduling for sgemm.
 
     // TODO Check if we should use 3D blocking.
@@ -729,8 +779,6 @@ static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
         }
     }
 
-    // TODO Check if we shoud use k-partitioning.
-
     int condition_1D_copya = 0;
     if (mayiuse(avx512_core)) {
         const dim_t thresh = isInteger ? 68 : N2D_MAX / 4;
@@ -772,9 +820,11 @@ static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
         *p_nthrs = nthrs_m * nthrs_n;
 
     } else if (condition_1D_copya && mkldnn_thr_syncable()) {
-        // Use parallel copy A algorithm
+        // Use parallel copy A algorithm. On multi-socket systems each NUMA
+        // node packs and shares its own copy of A to avoid remote accesses.
         thread_info->copy_type = COPY_A;
         thread_info->partition = PARTITION_1D_COL;
+        thread_info->ngroups = get_gemm_numa_groups(nthrs);
     } else {
         int veclen = 0;
         if (mayiuse(avx512_core)) {
@@ -913,6 +963,8 @@ static inline void decompose_matrices(const int ithr, int *nthrs, dim_t *m,
         const gemm_info_t<a_type, b_type, c_type> *arg) {
 
     dim_t strideAm = (arg->transa == no_trans)? 1 : arg->lda;
+    dim_t strideAn = (arg->transa != no_trans)? 1 : arg->lda;
+    dim_t strideBm = (arg->transb == no_trans)? 1 : arg->ldb;
     dim_t strideBn = (arg->transb != no_trans)? 1 : arg->ldb;
     int offsetc = arg->offsetc;
 
@@ -1029,6 +1081,33 @@ static inline void decompose_matrices(const int ithr, int *nthrs, dim_t *m,
             }
             break;
         }
+
+    case PARTITION_1D_K:
+        {
+            dim_t offset = 0;
+            dim_t block = 0;
+            partition_1d(ithr, *nthrs, arg->k, &offset, &block);
+
+            *m = arg->m;
+            *n = arg->n;
+            *k = block;
+
+            // Set matrix A.
+            *a = arg->a + offset * strideAn;
+
+            // Set matrix B.
+            *b = arg->b + offset * strideBm;
+
+            // Set matrix C. Partial results of all but the first thread are
+            // redirected to private buffers by the caller.
+            *c = arg->c;
+
+            // Set offset vector for C matrix
+            if (isInteger) {
+                *co = arg->co;
+            }
+            break;
+        }
     }
 }
 
@@ -1080,6 +1159,8 @@ static mkldnn_status_t parallel_a_copy(const int ithr, const int nthrs,
     size_t a_buf_nelems = m_padd * k_padd;
 
     // Allocate shared memory for A and its row sum buffers in master thread.
+    // The buffer is first touched by the copy kernels of the threads sharing
+    // it, so its pages end up on their NUMA node.
     if (ithr == 0) { // If thread master
         size_t mem_size = (a_buf_nelems * sizeof(*a) + PAGE_4K);
 
@@ -1287,10 +1368,47 @@ static mkldnn_status_t call_no_copy_sgemm(const int transa, const int transb,
                 beta, c, &ldc_s32, bias);
 }
 
+// Reduce the partial C matrices of the k-partitioning into C. Thread 0 has
+// written its partial sum together with beta * C straight into C.
+template <typename a_type, typename b_type, typename c_type>
+static void sum_k_partial_results(const int nthr, c_type **c_partial,
+        const gemm_info_t<a_type, b_type, c_type> *arg) {
+    const dim_t m = arg->m;
+    const dim_t n = arg->n;
+    const dim_t ldc = arg->ldc;
+
+    bool has_partial = false;
+    for (int i = 1; i < nthr; i++)
+        has_partial = has_partial || c_partial[i] != NULL;
+    if (!has_partial)
+        return;
+
+    // Same padding as used for allocation of the partial buffers.
+    const dim_t ldc_part = ld_padd<c_type>(m);
+    const dim_t m_blk = 256;
+    const dim_t nb_m = utils::div_up(m, m_blk);
+
+    parallel_nd(n, nb_m, [&](const dim_t j, const dim_t ib) {
+        const dim_t i_start = ib * m_blk;
+        const dim_t i_end = nstl::min(i_start + m_blk, m);
+        c_type *c = arg->c + j * ldc;
+        for (int ik = 1; ik < nthr; ik++) {
+            const c_type *c_part = c_partial[ik];
+            if (c_part == NULL)
+                continue;
+            c_part += j * ldc_part;
+            PRAGMA_OMP_SIMD()
+            for (dim_t i = i_start; i < i_end; i++)
+                c[i] += c_part[i];
+        }
+    });
+}
+
 #define CACHE_LINE_SIZE 64
 template <typename a_type, typename b_type, typename c_type>
 static mkldnn_status_t gemm_threading_driver(
-        gemm_info_t<a_type, b_type, c_type> *arg) {
+        gemm_info_t<a_type, b_type, c_type> *arg,
+        const gemm_tuning_hint_t &hint) {
 
     if ((arg->m <= 0) || (arg->n <= 0))
         return mkldnn_success;
@@ -1310,25 +1428,32 @@ static mkldnn_status_t gemm_threading_driver(
 
     int nthr = (mkldnn_in_parallel()) ? 1 : mkldnn_get_max_threads();
 
-    // Check if thread is beneficial.
-    if (mayiuse(avx2) && !mayiuse(avx512_core)) {
-        if (arg->m > 10 * arg->n && arg->n < nthr) {
-            const int veclen = cpu_isa_traits<avx2>::vlen / sizeof(c_type);
-            if (arg->m / nthr < veclen * 3) {
-                nthr = nstl::max(arg->m / veclen / 3, 1LL);
+    if (hint.nthr > 0) {
+        nthr = nstl::min(nthr, hint.nthr);
+    } else {
+        // Check if thread is beneficial.
+        if (mayiuse(avx2) && !mayiuse(avx512_core)) {
+            if (arg->m > 10 * arg->n && arg->n < nthr) {
+                const int veclen = cpu_isa_traits<avx2>::vlen
+                    / sizeof(c_type);
+                if (arg->m / nthr < veclen * 3) {
+                    nthr = nstl::max(arg->m / veclen / 3, 1LL);
+                }
             }
         }
+        get_omp_thread_count<c_type>(arg->m, arg->n, arg->k, &nthr);
     }
-    get_omp_thread_count<c_type>(arg->m, arg->n, arg->k, &nthr);
 
     if (nthr == 1) {
         return gemm_kernel_driver(arg->m, arg->n, arg->k, arg->a, arg->b,
-                arg->c, arg->co, arg);
+                *arg->beta, arg->c, arg->ldc, arg->co, arg);
     }
 
-    if ((data_traits<a_type>::data_type == data_type::f32) &&
-            nocopy_checker(nthr, arg->transa, arg->transb, arg->m, arg->n,
-                arg->k, arg->lda, arg->ldb, arg->ldc))
+    int nocopy = hint.nocopy >= 0 ? hint.nocopy
+        : nocopy_checker(nthr, arg->transa, arg->transb, arg->m, arg->n,
+                arg->k, arg->lda, arg->ldb, arg->ldc);
+
+    if ((data_traits<a_type>::data_type == data_type::f32) && nocopy)
         return call_no_copy_sgemm(arg->transa, arg->transb,
                 arg->m, arg->n, arg->k, arg->alpha,
                 (float *) arg->a, arg->lda,
@@ -1346,16 +1471,29 @@ static mkldnn_status_t gemm_threading_driver(
         results[i * CACHE_LINE_SIZE] = mkldnn_success; // Initialize to success
     }
 
-    char *shared_mem = NULL;
+    char *shared_mem[GEMM_MAX_NUMA_GROUPS] = {NULL};
+
+    // Private partial C matrices of the k-partitioning.
+    c_type **c_partial = (c_type **) malloc(sizeof(*c_partial) * nthr,
+            PAGE_4K);
+
+    if (!c_partial) {
+        mkldnn::impl::free(results);
+        return mkldnn_out_of_memory;
+    }
+
+    for (int i = 0; i < nthr; i++) {
+        c_partial[i] = NULL;
+    }
 
     parallel(nthr, [&](const int ithr, const int nthr) {
         int nthrs = nthr;
         if (nthrs == 1) {
             results[0] = gemm_kernel_driver(arg->m, arg->n, arg->k, arg->a,
-                arg->b, arg->c, arg->co, arg);
+                arg->b, *arg->beta, arg->c, arg->ldc, arg->co, arg);
         } else {
             blas_thread_t thread_info;
-            set_thread_opts(&nthrs, &thread_info, arg);
+            set_thread_opts(&nthrs, &thread_info, arg, hint);
 
             const a_type *a = NULL;
             const b_type *b = NULL;
@@ -1370,15 +1508,46 @@ static mkldnn_status_t gemm_threading_driver(
             if (ithr < nthrs) {
                 switch (thread_info.copy_type) {
                 case COPY_A:
-                    results[ithr * CACHE_LINE_SIZE] =
-                        parallel_a_copy(ithr, nthrs, m, n, k, a, b, c, co, arg,
-                                &shared_mem);
+                    {
+                        // Threads are split into equally sized groups of
+                        // consecutive ids, one per NUMA node. Columns of
+                        // B and C are already partitioned contiguously,
+                        // so each group only needs A to be packed in
+                        // memory local to its node. All groups run the
+                        // same number of A blocks, which keeps the global
+                        // barriers in parallel_a_copy matched.
+                        int nthrs_grp = nthrs / thread_info.ngroups;
+                        int igrp = ithr / nthrs_grp;
+                        results[ithr * CACHE_LINE_SIZE] =
+                            parallel_a_copy(ithr % nthrs_grp, nthrs_grp, m, n,
+                                    k, a, b, c, co, arg, &shared_mem[igrp]);
+                    }
                     break;
 
                 default:
                 case COPY_NONE:
-                    results[ithr * CACHE_LINE_SIZE] =
-                        gemm_kernel_driver(m, n, k, a, b, c, co, arg);
+                    if (thread_info.partition == PARTITION_1D_K && ithr > 0) {
+                        // Partial sums of all but the first k-block go to
+                        // private buffers and are reduced into C later.
+                        if (k <= 0)
+                            break;
+                        dim_t ldc_part = ld_padd<c_type>(m);
+                        c_type *c_part = (c_type *) malloc(
+                                sizeof(*c_part) * ldc_part * n, PAGE_4K);
+                        if (!c_part) {
+                            results[ithr * CACHE_LINE_SIZE] =
+                                mkldnn_out_of_memory;
+                            break;
+                        }
+                        c_partial[ithr] = c_part;
+                        results[ithr * CACHE_LINE_SIZE] =
+                            gemm_kernel_driver(m, n, k, a, b, 0.0f, c_part,
+                                    ldc_part, co, arg);
+                    } else {
+                        results[ithr * CACHE_LINE_SIZE] =
+                            gemm_kernel_driver(m, n, k, a, b, *arg->beta, c,
+                                    arg->ldc, co, arg);
+                    }
                     break;
 
                 case NO_COPY:
@@ -1419,12 +1588,99 @@ static mkldnn_status_t gemm_threading_driver(
         }
     }
 
+    if (result == mkldnn_success)
+        sum_k_partial_results(nthr, c_partial, arg);
+
+    for (int i = 0; i < nthr; i++) {
+        mkldnn::impl::free(c_partial[i]);
+    }
+
+    mkldnn::impl::free(c_partial);
     mkldnn::impl::free(results);
 
     return result;
 }
 #undef CACHE_LINE_SIZE
 
+// Times the gemm with a sweep over thread counts, copy/no-copy kernels and
+// partitionings and returns the fastest choice. C is left untouched.
+template <typename a_type, typename b_type, typename c_type>
+static mkldnn_status_t gemm_autotune(
+        const gemm_info_t<a_type, b_type, c_type> *arg,
+        gemm_tuning_hint_t *best) {
+    const bool isInteger = data_traits<a_type>::data_type == data_type::s8;
+    const int max_nthr = mkldnn_get_max_threads();
+    const int ntimes = 3;
+
+    const size_t c_nelems = arg->ldc * arg->n;
+    c_type *c_copy = (c_type *) malloc(2 * sizeof(c_type) * c_nelems,
+            PAGE_4K);
+    if (!c_copy)
+        return mkldnn_out_of_memory;
+    c_type *c_work = c_copy + c_nelems;
+    utils::array_copy(c_copy, arg->c, c_nelems);
+
+    gemm_info_t<a_type, b_type, c_type> tune_arg = *arg;
+    tune_arg.c = c_work;
+
+    int nthrs[32];
+    int n_nthrs = 0;
+    for (int nthr = 1; nthr < max_nthr && n_nthrs < 31; nthr *= 2)
+        nthrs[n_nthrs++] = nthr;
+    nthrs[n_nthrs++] = max_nthr;
+
+    const int partitions[] = {-1, PARTITION_1D_ROW, PARTITION_1D_COL,
+        PARTITION_1D_K};
+
+    mkldnn_status_t status = mkldnn_success;
+    double best_ms = 0;
+    *best = gemm_tuning_hint_t();
+
+    for (int i = 0; i < n_nthrs && status == mkldnn_success; i++)
+    for (int nocopy = 0; nocopy <= (isInteger ? 0 : 1); nocopy++)
+    for (auto partition : partitions) {
+        gemm_tuning_hint_t hint;
+        hint.nthr = nthrs[i];
+        hint.nocopy = nocopy;
+        hint.partition = partition;
+
+        // No-copy kernels do their own threading, and partitioning only
+        // matters for multithreaded copy-based kernels.
+        if (nocopy && hint.nthr != max_nthr)
+            continue;
+        if (partition != -1 && (nocopy || hint.nthr == 1))
+            continue;
+        if (partition == PARTITION_1D_K
+                && (isInteger || arg->k < hint.nthr))
+            continue;
+
+        double ms = 0;
+        for (int t = 0; t <= ntimes; t++) {
+            utils::array_copy(c_work, c_copy, c_nelems);
+            double start = get_msec();
+            status = gemm_threading_driver(&tune_arg, hint);
+            if (status != mkldnn_success)
+                break;
+            // The first run warms up caches and is not timed.
+            double cur_ms = get_msec() - start;
+            if (t == 1 || (t > 1 && cur_ms < ms))
+                ms = cur_ms;
+        }
+
+        if (status != mkldnn_success)
+            break;
+
+        if (best->nthr == 0 || ms < best_ms) {
+            *best = hint;
+            best_ms = ms;
+        }
+    }
+
+    free(c_copy);
+
+    return status;
+}
+
 template <typename a_type, typename b_type, typename c_type>
 mkldnn_status_t gemm_driver(
         const char *transA, const char *transB, const char *offsetC,
@@ -1448,7 +1704,27 @@ mkldnn_status_t gemm_driver(
     // Check if copy algorithm kernels were generated on supported ISAs.
     assert(args.hasKernels());
 
-    return gemm_threading_driver(&args);
+    gemm_tuning_hint_t hint;
+    if (!args.force_nocopy && !mkldnn_in_parallel()) {
+        gemm_tuning_key_t key;
+        key.a_dt = data_traits<a_type>::data_type;
+        key.b_dt = data_traits<b_type>::data_type;
+        key.transa = args.transa;
+        key.transb = args.transb;
+        key.m = args.m;
+        key.n = args.n;
+        key.k = args.k;
+        key.max_nthr = mkldnn_get_max_threads();
+
+        if (!gemm_tuning_find(key, &hint) && gemm_tuning_mode()) {
+            mkldnn_status_t status = gemm_autotune(&args, &hint);
+            if (status != mkldnn_success)
+                return status;
+            gemm_tuning_record(key, hint);
+        }
+    }
+
+    return gemm_threading_driver(&args, hint);
 }
 
 template // Instantiate gemm_s8u8s32
@@ -1460,6 +1736,15 @@ mkldnn_status_t gemm_driver<int8_t, uint8_t, int32_t>(
         const float *beta, int32_t *c, const int *ldc, const int32_t *oc,
         const bool force_nocopy);
 
+template // Instantiate gemm_s8s8s32
+mkldnn_status_t gemm_driver<int8_t, int8_t, int32_t>(
+        const char *transA, const char *transB, const char *offsetC,
+        const int *m, const int *n, const int *k,
+        const float *alpha, const int8_t *a, const int *lda, const int8_t *oa,
+        const int8_t *b, const int *ldb, const int8_t *ob,
+        const float *beta, int32_t *c, const int *ldc, const int32_t *oc,
+        const bool force_nocopy);
+
 template // Instantiate sgemm
 mkldnn_status_t gemm_driver<float, float, float>(
         const char *transA, const char *transB, const char *offsetC,
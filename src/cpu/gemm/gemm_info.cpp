@@ -73,6 +73,15 @@ gemm_info_t<a_type, b_type, c_type>::gemm_info_t(const char *transA,
         this->bo = *ob;
     }
 
+    // For gemm_s8s8s32 the packed B blocks are moved to the u8 domain
+    // (b + 128) right after copying, so compute kernels see a s8u8s32
+    // problem with B offset equal to -128. The compensation op(A) * B_offset
+    // then comes from the row sums computed by the A copy kernels.
+    if (data_traits<b_type>::data_type == data_type::s8) {
+        assert(this->bo == 0);
+        this->bo = -128;
+    }
+
 
     if (offsetC != NULL) {
         char offsetc = *offsetC;
@@ -361,6 +370,9 @@ bool gemm_info_t<a_type, b_type, c_type>::hasKernels(void) {
 template // For gemm_s8u8s32
 struct gemm_info_t<int8_t, uint8_t, int32_t>;
 
+template // For gemm_s8s8s32
+struct gemm_info_t<int8_t, int8_t, int32_t>;
+
 template // For sgemm.
 struct gemm_info_t<float, float, float>;
 
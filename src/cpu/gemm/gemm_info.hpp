@@ -28,6 +28,7 @@ enum {
     PARTITION_1D_COL,
     PARTITION_2D_COL_MAJOR,
     PARTITION_2D = PARTITION_2D_COL_MAJOR,
+    PARTITION_1D_K,
 };
 
 enum {
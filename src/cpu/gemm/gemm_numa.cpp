@@ -0,0 +1,110 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gemm_numa.hpp"
+
+#include "nstl.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+struct numa_topology_t {
+    int nnodes;
+    int ncpus[GEMM_MAX_NUMA_GROUPS];
+
+    numa_topology_t() : nnodes(0) {
+#if defined(__linux__)
+        // Threads are normally bound one per core, so count cores rather
+        // than hardware threads.
+        int smt = count_cpus(
+                "/sys/devices/system/cpu/cpu0/topology/thread_siblings_list");
+        if (smt <= 0)
+            smt = 1;
+
+        // Nodes are numbered densely on all but exotic systems, so stop at
+        // the first missing one.
+        for (int node = 0; node < GEMM_MAX_NUMA_GROUPS; node++) {
+            char path[64];
+            snprintf(path, sizeof(path),
+                    "/sys/devices/system/node/node%d/cpulist", node);
+            int cpus = count_cpus(path);
+            if (cpus <= 0)
+                break;
+            ncpus[nnodes++] = nstl::max(cpus / smt, 1);
+        }
+#endif
+    }
+
+private:
+    // Counts CPUs in a list file such as "0-27,56-83". Returns -1 if the file
+    // cannot be read.
+    static int count_cpus(const char *path) {
+        FILE *fp = fopen(path, "r");
+        if (!fp)
+            return -1;
+
+        int count = 0;
+        int first = 0, last = 0;
+        char sep = 0;
+        while (fscanf(fp, "%d", &first) == 1) {
+            last = first;
+            if (fscanf(fp, "%c", &sep) != 1)
+                sep = 0;
+            if (sep == '-') {
+                if (fscanf(fp, "%d", &last) != 1)
+                    break;
+                if (fscanf(fp, "%c", &sep) != 1)
+                    sep = 0;
+            }
+            count += last - first + 1;
+            if (sep != ',')
+                break;
+        }
+        fclose(fp);
+
+        return count;
+    }
+};
+
+}
+
+int get_gemm_numa_groups(int nthr) {
+    static const bool enabled = getenv_int("MKLDNN_GEMM_NUMA", 1) != 0;
+    static const numa_topology_t topo;
+
+    if (!enabled || topo.nnodes <= 1 || nthr <= 1)
+        return 1;
+
+    int ngroups = 0;
+    for (int spanned = 0; ngroups < topo.nnodes && spanned < nthr; ngroups++)
+        spanned += topo.ncpus[ngroups];
+
+    if (ngroups <= 1 || nthr % ngroups != 0)
+        return 1;
+
+    return ngroups;
+}
+
+}
+}
+}
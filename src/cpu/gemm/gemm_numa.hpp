@@ -0,0 +1,38 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GEMM_NUMA_HPP
+#define GEMM_NUMA_HPP
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+// Maximum number of NUMA groups the gemm driver splits a thread team into.
+#define GEMM_MAX_NUMA_GROUPS 8
+
+// Returns the number of NUMA nodes spanned by a team of nthr threads, assuming
+// threads are bound compactly (thread i runs on the i-th core, nodes filled
+// one after another). Returns 1 if the topology is unknown, if the team fits
+// into a single node, if nthr is not a multiple of the number of nodes or if
+// the MKLDNN_GEMM_NUMA environment variable is set to 0.
+int get_gemm_numa_groups(int nthr);
+
+}
+}
+}
+
+#endif // GEMM_NUMA_HPP
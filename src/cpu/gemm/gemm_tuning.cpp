@@ -0,0 +1,165 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <mutex>
+#include <vector>
+
+#include "mkldnn_debug.h"
+
+#include "gemm_tuning.hpp"
+
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+struct gemm_tuning_entry_t {
+    gemm_tuning_key_t key;
+    gemm_tuning_hint_t hint;
+};
+
+const int path_len = 1024;
+char tuning_file[path_len] = {0};
+bool tuning_mode = false;
+
+std::vector<gemm_tuning_entry_t> tuning_table;
+std::mutex tuning_mutex;
+std::once_flag tuning_init_flag;
+
+bool str2dt(const char *str, data_type_t *dt) {
+    const data_type_t dts[] = {data_type::f32, data_type::s8, data_type::u8};
+    for (auto d : dts) {
+        if (!strcmp(str, mkldnn_dt2str(d))) {
+            *dt = d;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_entry(const char *line, gemm_tuning_entry_t *e) {
+    char a_dt[8], b_dt[8], transa, transb;
+    long long m, n, k;
+    int max_nthr, nthr, nocopy, partition;
+
+    int nitems = sscanf(line, "%7s %7s %c %c %lld %lld %lld %d %d %d %d",
+            a_dt, b_dt, &transa, &transb, &m, &n, &k, &max_nthr, &nthr,
+            &nocopy, &partition);
+    if (nitems != 11)
+        return false;
+
+    if (!str2dt(a_dt, &e->key.a_dt) || !str2dt(b_dt, &e->key.b_dt))
+        return false;
+
+    e->key.transa = (transa == 'N' || transa == 'n') ? no_trans : do_trans;
+    e->key.transb = (transb == 'N' || transb == 'n') ? no_trans : do_trans;
+    e->key.m = m;
+    e->key.n = n;
+    e->key.k = k;
+    e->key.max_nthr = max_nthr;
+    e->hint.nthr = nthr;
+    e->hint.nocopy = nocopy;
+    e->hint.partition = partition;
+
+    return nthr >= 0 && nocopy >= -1 && nocopy <= 1 && partition >= -1
+        && partition <= PARTITION_1D_K;
+}
+
+void load_table() {
+    if (getenv("MKLDNN_GEMM_TUNING_FILE", tuning_file, path_len) <= 0) {
+        tuning_file[0] = '\0';
+        return;
+    }
+
+    tuning_mode = getenv_int("MKLDNN_GEMM_TUNING_MODE") == 1;
+
+    FILE *fp = fopen(tuning_file, "r");
+    if (!fp)
+        return;
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+        gemm_tuning_entry_t e;
+        if (parse_entry(line, &e))
+            tuning_table.push_back(e);
+    }
+
+    fclose(fp);
+}
+
+}
+
+void gemm_tuning_init() {
+    std::call_once(tuning_init_flag, load_table);
+}
+
+bool gemm_tuning_mode() {
+    gemm_tuning_init();
+    return tuning_mode;
+}
+
+bool gemm_tuning_find(const gemm_tuning_key_t &key, gemm_tuning_hint_t *hint) {
+    gemm_tuning_init();
+
+    // The table is only modified in tuning mode, so the common case does not
+    // need to lock.
+    std::unique_lock<std::mutex> lock(tuning_mutex, std::defer_lock);
+    if (tuning_mode)
+        lock.lock();
+
+    for (const auto &e : tuning_table) {
+        if (e.key == key) {
+            *hint = e.hint;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void gemm_tuning_record(const gemm_tuning_key_t &key,
+        const gemm_tuning_hint_t &hint) {
+    std::lock_guard<std::mutex> guard(tuning_mutex);
+
+    gemm_tuning_entry_t e;
+    e.key = key;
+    e.hint = hint;
+    tuning_table.push_back(e);
+
+    FILE *fp = fopen(tuning_file, "a");
+    if (!fp)
+        return;
+
+    fprintf(fp, "%s %s %c %c %lld %lld %lld %d %d %d %d\n",
+            mkldnn_dt2str(key.a_dt), mkldnn_dt2str(key.b_dt),
+            key.transa == no_trans ? 'N' : 'T',
+            key.transb == no_trans ? 'N' : 'T',
+            key.m, key.n, key.k, key.max_nthr,
+            hint.nthr, hint.nocopy, hint.partition);
+
+    fclose(fp);
+}
+
+}
+}
+}
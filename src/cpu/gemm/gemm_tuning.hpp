@@ -0,0 +1,79 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GEMM_TUNING_HPP
+#define GEMM_TUNING_HPP
+
+#include "c_types_map.hpp"
+#include "gemm_info.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+// Measured gemm threading choices.
+//
+// The table is read from the file named by MKLDNN_GEMM_TUNING_FILE. If
+// MKLDNN_GEMM_TUNING_MODE is set to 1 as well, every gemm call whose shape
+// is not in the table yet is timed with a sweep over thread counts,
+// copy/no-copy kernels and partitionings, and the fastest choice is appended
+// to the file. Each line of the file holds one entry:
+//
+//   a_dt b_dt transa transb m n k max_nthr nthr nocopy partition
+//
+// e.g. "f32 f32 N T 64 64 20000 28 28 0 3". Lines starting with '#' are
+// ignored. Entries only apply if max_nthr matches mkldnn_get_max_threads().
+
+struct gemm_tuning_key_t {
+    data_type_t a_dt, b_dt;
+    int transa, transb;
+    dim_t m, n, k;
+    int max_nthr;
+
+    bool operator==(const gemm_tuning_key_t &rhs) const {
+        return a_dt == rhs.a_dt && b_dt == rhs.b_dt && transa == rhs.transa
+            && transb == rhs.transb && m == rhs.m && n == rhs.n && k == rhs.k
+            && max_nthr == rhs.max_nthr;
+    }
+};
+
+struct gemm_tuning_hint_t {
+    int nthr; // Number of threads, 0 means use the heuristic
+    int nocopy; // 1 no-copy kernels, 0 copy-based kernels, -1 heuristic
+    int partition; // One of PARTITION_*, -1 means use the heuristic
+
+    gemm_tuning_hint_t() : nthr(0), nocopy(-1), partition(-1) {}
+};
+
+// Reads the tuning table. Called on the first lookup, subsequent calls are
+// no-ops.
+void gemm_tuning_init();
+
+// Returns true if new shapes should be tuned and recorded.
+bool gemm_tuning_mode();
+
+// Looks up the hint for a gemm shape. Returns false if there is none.
+bool gemm_tuning_find(const gemm_tuning_key_t &key, gemm_tuning_hint_t *hint);
+
+// Adds a tuned entry to the table and appends it to the tuning file.
+void gemm_tuning_record(const gemm_tuning_key_t &key,
+        const gemm_tuning_hint_t &hint);
+
+}
+}
+}
+
+#endif // GEMM_TUNING_HPP
@@ -33,6 +33,11 @@ template <>
 int gemm_s8u8s32_jump_to_gemv_s8u8s32(
         gemm_info_t<float, float, float> *arg) { return 0; }
 
+// gemv kernels have no B offset support which gemm_s8s8s32 relies on.
+template <>
+int gemm_s8u8s32_jump_to_gemv_s8u8s32(
+        gemm_info_t<int8_t, int8_t, int32_t> *arg) { return 0; }
+
 template <>
 int gemm_s8u8s32_jump_to_gemv_s8u8s32(
         gemm_info_t<int8_t, uint8_t, int32_t> *arg) {
@@ -174,6 +179,8 @@ int gemv_threading_driver(gemm_info_t<int8_t, uint8_t, int32_t> *arg) {
                     new_y[i] = arg->c[i * arg->ldc];
                 }
             }
+            arg_seq.c = new_y;
+            arg_seq.ldc = 1;
         }
 
         status = gemv_kernel_driver(&arg_seq);
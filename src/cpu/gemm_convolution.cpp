@@ -77,13 +77,6 @@ void gemm_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
             data_t *_dst_im = dst + (n * jcp.ngroups + g) * dst_step;
             const int h_step = nstl::min(jcp.oh_block, jcp.oh - oh);
             const int w_step = nstl::min(jcp.ow_block, jcp.ow - ow);
-            if (jcp.im2col_sz) {
-                if (jcp.id == 1)
-                    jit_gemm_convolution_utils::im2col(
-                            jcp, _src, _col, oh, h_step, ow, w_step);
-                else
-                    jit_gemm_convolution_utils::im2col_3d(jcp, _src, _col, od);
-            }
 
             const data_t one = 1.0;
 
@@ -91,9 +84,25 @@ void gemm_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
             const int LDA = jcp.im2col_sz ? m : M;
             data_t *_dst = _dst_im + od * jcp.os + oh * jcp.ow + ow;
 
-            extended_sgemm("N", "N", &m, &N, &K, &one,
-                    jcp.im2col_sz ? _col : _src + od * m, &LDA, _weights, &K,
-                    &this->beta_, _dst, &M);
+            // The col buffer only holds ic_block channels, the products of
+            // the chunks are accumulated in dst
+            for (int ic = 0; ic < jcp.ic; ic += jcp.ic_block) {
+                const int ic_step = nstl::min(jcp.ic_block, jcp.ic - ic);
+                if (jcp.im2col_sz) {
+                    if (jcp.id == 1)
+                        jit_gemm_convolution_utils::im2col(jcp, _src, _col,
+                                oh, h_step, ow, w_step, ic, ic_step);
+                    else
+                        jit_gemm_convolution_utils::im2col_3d(
+                                jcp, _src, _col, od, ic, ic_step);
+                }
+
+                const int k = ic_step * jcp.ks;
+                extended_sgemm("N", "N", &m, &N, &k, &one,
+                        jcp.im2col_sz ? _col : _src + od * m, &LDA,
+                        _weights + ic * jcp.ks, &K,
+                        ic == 0 ? &this->beta_ : &one, _dst, &M);
+            }
 
             data_t *d = _dst;
             if (eltwise_) {
@@ -255,11 +264,11 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights(
 
                     if (jcp.im2col_sz) {
                         if (jcp.id == 1)
-                            jit_gemm_convolution_utils::im2col(
-                                    jcp, _src, _col, 0, jcp.oh, 0, jcp.ow);
+                            jit_gemm_convolution_utils::im2col(jcp, _src,
+                                    _col, 0, jcp.oh, 0, jcp.ow, 0, jcp.ic);
                         else
                             jit_gemm_convolution_utils::im2col_3d(jcp, _src,
-                                _col, od);
+                                _col, od, 0, jcp.ic);
                     }
 
                     const data_t zero = 0.0, one = 1.0;
@@ -36,15 +36,17 @@ using namespace data_type;
 
 namespace jit_gemm_convolution_utils {
 
+/* col[ic][kd][kh][kw][oh][ow] <-- im2col_3d(im[ic][id][ih][iw]) for
+ * ic in [cs, cs + cb) */
 void im2col_3d(const jit_gemm_conv_conf_t &jcp, const float *im, float *col,
-        int od)
+        int od, int cs, int cb)
 {
     const size_t OHW = jcp.oh * jcp.ow;
     const size_t im_step = jcp.ih * jcp.iw * jcp.id;
     const size_t col_step = jcp.ks * OHW;
 
-    parallel_nd(jcp.ic, [&](int ic) {
-        const float *__restrict im_loc = im + ic * im_step;
+    parallel_nd(cb, [&](int ic) {
+        const float *__restrict im_loc = im + (ic + cs) * im_step;
         float *__restrict col_loc = col + ic * col_step;
         int id = od * jcp.stride_d - jcp.f_pad;
         for (int kd = 0; kd < jcp.kd; ++kd) {
@@ -119,10 +121,11 @@ void im2col_3d(const jit_gemm_conv_conf_t &jcp, const float *im, float *col,
     });
 }
 
-/* col[ic][kh][kw][oh][ow] <-- im2col(im[ic][ih][iw]) */
+/* col[ic][kh][kw][oh][ow] <-- im2col(im[ic][ih][iw]) for ic in [cs, cs + cb) */
 void im2col(const jit_gemm_conv_conf_t &jcp, const float *__restrict im,
-       float *__restrict col, int hs, int hb, int ws, int wb) {
+       float *__restrict col, int hs, int hb, int ws, int wb, int cs, int cb) {
     const size_t im_step = jcp.is;
+    im += cs * im_step;
     const size_t col_step = jcp.ks * hb * wb;
     if (jcp.stride_w == 1) {
         // Generated code is more optimized for stride_w == 1
@@ -151,14 +154,14 @@ void im2col(const jit_gemm_conv_conf_t &jcp, const float *__restrict im,
         };
 
         if (jcp.outer_threading) {
-            for (int ic = 0; ic < jcp.ic; ic++)
+            for (int ic = 0; ic < cb; ic++)
                 for (int kh = 0; kh < jcp.kh; kh++)
                     for (int kw = 0; kw < jcp.kw; kw++)
                         for (int oh = 0; oh < hb; oh++)
                             ker(ic, kh, kw, oh);
         }
         else {
-            parallel_nd(jcp.ic, jcp.kh, jcp.kw, hb, ker);
+            parallel_nd(cb, jcp.kh, jcp.kw, hb, ker);
         }
     } else if (jcp.ic == 1) {
         parallel_nd(jcp.kh, hb, [&](int kh, int oh) {
@@ -189,7 +192,7 @@ void im2col(const jit_gemm_conv_conf_t &jcp, const float *__restrict im,
         });
     } else {
 
-        parallel_nd(jcp.ic, jcp.kh, jcp.kw, hb,
+        parallel_nd(cb, jcp.kh, jcp.kw, hb,
             [&](int ic, int kh, int kw, int oh) {
             const float *__restrict im_ = im + ic * im_step;
             float *__restrict col_ = col + ic * col_step
@@ -219,11 +222,12 @@ inline int limit(int low, int upper, int value) {
     return nstl::max(low, nstl::min(upper, value));
 }
 
-/* col[kh][kw][ic][oh][ow] <-- im2col_u8(im[ih][iw][ic]) */
+/* col[kh][kw][ic][oh][ow] <-- im2col_u8(im[ih][iw][ic]) for kh in
+ * [khs, khs + khb) */
 template <typename T>
 void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
         T *__restrict imtr, uint8_t *__restrict col, int hs, int hb, int ws,
-        int wb) {
+        int wb, int khs, int khb) {
     uint8_t shift = jcp.signed_input ? 128 : 0;
     const int dh = 1 + jcp.dilate_h;
     const int dw = 1 + jcp.dilate_w;
@@ -248,7 +252,9 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
 
         const int imtr_ic_stride = ihb * iwb;
         const ptrdiff_t imtr_idx_shift = ih_start * iwb + iw_start;
-        for (int ic = 0; ic < jcp.ic; ic++) {
+        /* the transposed block is reused by the later chunks of kh */
+        const int ic_tr = khs == 0 ? jcp.ic : 0;
+        for (int ic = 0; ic < ic_tr; ic++) {
             const ptrdiff_t imtr_idx_ic = ic * imtr_ic_stride - imtr_idx_shift;
             for (int ih = ih_start; ih < ih_end; ih++) {
                 const ptrdiff_t im_idx_ih = ic + ih * im_ih_stride;
@@ -264,8 +270,8 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
 
         const int oh_init = ih_start - hp;
         const int ow_init = iw_start - wp;
-        for (int kh = 0; kh < jcp.kh; kh++) {
-            const ptrdiff_t col_idx_kh = kh * col_kh_stride;
+        for (int kh = khs; kh < khs + khb; kh++) {
+            const ptrdiff_t col_idx_kh = (kh - khs) * col_kh_stride;
             const int oh_kh = oh_init - kh;
             const int oh_start = limit(0, hb, oh_kh);
             const int oh_end = limit(0, hb, oh_kh + ihb);
@@ -304,9 +310,9 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
             }
         }
     } else {
-        parallel_nd(jcp.kh, jcp.kw, jcp.ic, hb,
+        parallel_nd(khb, jcp.kw, jcp.ic, hb,
             [&](int kh, int kw, int ic, int oh) {
-                const int hp = tp - kh * dh;
+                const int hp = tp - (kh + khs) * dh;
                 const int ih = (oh + hs) * sh - hp;
                 const ptrdiff_t col_idx_base
                         = (((kh * jcp.kw + kw) * jcp.ic + ic) * hb + oh) * wb;
@@ -337,10 +343,12 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
 
 template void im2col_u8<int8_t>(const jit_gemm_conv_conf_t &jcp,
         const int8_t *__restrict im, int8_t *__restrict imtr,
-        uint8_t *__restrict col, int hs, int hb, int ws, int wb);
+        uint8_t *__restrict col, int hs, int hb, int ws, int wb, int khs,
+        int khb);
 template void im2col_u8<uint8_t>(const jit_gemm_conv_conf_t &jcp,
         const uint8_t *__restrict im, uint8_t *__restrict imtr,
-        uint8_t *__restrict col, int hs, int hb, int ws, int wb);
+        uint8_t *__restrict col, int hs, int hb, int ws, int wb, int khs,
+        int khb);
 
 /* im[ih][iw][ic] <-- col2im_s32(col[oh][ow][kh][kw][ic]) */
 void col2im_s32(const jit_gemm_conv_conf_t &jcp, const int32_t *__restrict col,
@@ -638,6 +646,24 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
             jcp.ow_block = ow;
         jcp.im2col_sz = (ptrdiff_t)ic * jcp.ks * jcp.oh_block * jcp.ow_block;
     }
+    // The col buffer of a block is built and multiplied a chunk of K at a
+    // time when it does not fit into the thread's share of the last level
+    // cache, so large kernels and 3D shapes do not materialize the whole
+    // im2col in the scratchpad. Returns the number of units (ic for f32, kh
+    // for int8) per chunk.
+    auto get_k_block = [&](int nb_units, size_t unit_sz) {
+        const bool per_core = jcp.nthr != 1;
+        size_t llc = get_cache_size(3, per_core);
+        if (llc == 0)
+            llc = get_cache_size(2, per_core);
+        const int k_block = (int)nstl::max((size_t)1,
+                nstl::min((size_t)nb_units, llc / unit_sz));
+        return div_up(nb_units, div_up(nb_units, k_block));
+    };
+
+    jcp.ic_block = jcp.ic;
+    jcp.kh_block = jcp.kh;
+
     //  For threading selection in bwd_d we do:
     //  1. Rough estimation of efficiency for inner and outer threading.
     //  2. Gemm size estimation in assumption that it does not work
@@ -662,6 +688,12 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
                      || (jcp.os * jcp.ic * jcp.oc) / max_threads < gemm_thrld);
             }
             jcp.nthr = jcp.outer_threading ? max_threads : 1;
+            if (jcp.im2col_sz) {
+                const size_t kh_sz = (size_t)jcp.kw * jcp.ic * jcp.oh_block
+                    * jcp.ow_block;
+                jcp.kh_block = get_k_block(jcp.kh, kh_sz);
+                jcp.im2col_sz = (ptrdiff_t)jcp.kh_block * kh_sz;
+            }
             scratchpad.book(key_conv_gemm_col,
                 sizeof(int8_t) * jcp.nthr * jcp.im2col_sz);
             scratchpad.book(key_conv_int_dat_in_acc_dt,
@@ -723,6 +755,11 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
                 && (jcp.mb != 1 || jcp.ngroups > 2);
 
         jcp.nthr = jcp.outer_threading ? max_threads : 1;
+        if (is_fwd && jcp.im2col_sz) {
+            const size_t ic_sz = (size_t)jcp.ks * jcp.oh_block * jcp.ow_block;
+            jcp.ic_block = get_k_block(jcp.ic, sizeof(float) * ic_sz);
+            jcp.im2col_sz = (ptrdiff_t)jcp.ic_block * ic_sz;
+        }
         scratchpad.book(key_conv_gemm_col,
                 sizeof(float) * jcp.nthr * jcp.im2col_sz);
 
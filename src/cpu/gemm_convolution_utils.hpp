@@ -32,13 +32,13 @@ namespace cpu {
 namespace jit_gemm_convolution_utils {
 
 void im2col_3d(const jit_gemm_conv_conf_t &jcp, const float *im, float *col,
-        int od);
+        int od, int cs, int cb);
 void im2col(const jit_gemm_conv_conf_t &jcp, const float *__restrict im,
-       float *__restrict col, int hs, int hb, int ws, int wb);
+       float *__restrict col, int hs, int hb, int ws, int wb, int cs, int cb);
 template <typename T>
 void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
         T* __restrict imtr, uint8_t *__restrict col,
-        int hs, int hb, int ws, int wb);
+        int hs, int hb, int ws, int wb, int khs, int khb);
 
 void col2im_s32(const jit_gemm_conv_conf_t &jcp, const int32_t *__restrict col,
         int32_t *__restrict im);
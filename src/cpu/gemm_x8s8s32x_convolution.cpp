@@ -593,10 +593,6 @@ execute_forward_thr(const int ithr, const int nthr, const src_data_t *src_base,
         const int h_step = nstl::min(jcp.oh_block, jcp.oh - oh);
         const int w_step = nstl::min(jcp.ow_block, jcp.ow - ow);
 
-        if (jcp.im2col_sz)
-            jit_gemm_convolution_utils::im2col_u8<src_data_t>(
-                    jcp, src, imtr, col, oh, h_step, ow, w_step);
-
         const int M = jcp.oc;
         const int K = jcp.ks * jcp.ic;
         const int N = h_step * w_step;
@@ -606,10 +602,24 @@ execute_forward_thr(const int ithr, const int nthr, const src_data_t *src_base,
         const int8_t off_a = 0, off_b = 0;
         const int32_t off_c = 0;
         const float onef = 1.0, zerof = 0.0;
-        gemm_s8x8s32("N", BT, jcp.signed_input ? "C" : "F",
-            &M, &N, &K, &onef, wei, &LDA, &off_a,
-            jcp.im2col_sz ? col : (uint8_t *)src, &LDB, &off_b,
-            &zerof, acc, &M, jcp.signed_input ? wei_comp : &off_c);
+
+        // The col buffer only holds kh_block rows of the kernel, the
+        // products of the chunks are accumulated in acc and the compensation
+        // is added with the first one
+        for (int kh = 0; kh < jcp.kh; kh += jcp.kh_block) {
+            const int kh_step = nstl::min(jcp.kh_block, jcp.kh - kh);
+            if (jcp.im2col_sz)
+                jit_gemm_convolution_utils::im2col_u8<src_data_t>(jcp, src,
+                        imtr, col, oh, h_step, ow, w_step, kh, kh_step);
+
+            const int k = kh_step * jcp.kw * jcp.ic;
+            const bool first = kh == 0;
+            gemm_s8x8s32("N", BT, jcp.signed_input && first ? "C" : "F",
+                &M, &N, &k, &onef, wei + (ptrdiff_t)kh * jcp.kw * jcp.ic * LDA,
+                &LDA, &off_a, jcp.im2col_sz ? col : (uint8_t *)src, &LDB,
+                &off_b, first ? &zerof : &onef, acc, &M,
+                jcp.signed_input && first ? wei_comp : &off_c);
+        }
 
         auto wei_adj_scale =
             (wei_md.extra().flags & memory_extra_flags::scale_adjust)
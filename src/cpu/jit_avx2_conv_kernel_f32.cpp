@@ -36,6 +36,18 @@ using namespace mkldnn::impl::utils;
 
 using namespace Xbyak;
 
+namespace {
+bool is_nxc(format_tag_t tag) { return one_of(tag, nwc, nhwc, ndhwc); }
+
+/* Channel tails of non-blocked activations are loaded and stored with
+ * vmaskmovps, the mask for a tail of t channels starts at &tail_mask[8 - t] */
+const uint32_t tail_mask[16] = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+    0, 0, 0, 0, 0, 0, 0, 0,
+};
+}
+
 void jit_avx2_conv_fwd_kernel_f32::oh_step_unroll_kw(int ur_w,
         int pad_l, int pad_r, int oc_blocks)
 {
@@ -50,20 +62,28 @@ void jit_avx2_conv_fwd_kernel_f32::oh_step_unroll_kw(int ur_w,
     int dilate_w = jcp.dilate_w + 1;
     int ic_blk = jcp.ic_block;
     int oc_blk = jcp.oc_block;
+    const int inp_mult = src_pixel_stride();
+    const int ic_tail = is_nxc(jcp.src_tag)
+        ? jcp.ic_without_padding % ic_blk : 0;
 
     for (int ki = 0; ki < kw; ki++) {
         int jj_start = nstl::max(0, div_up(pad_l - ki * dilate_w, stride_w));
         int jj_end = ur_w
             - nstl::max(0, div_up(ki*dilate_w+pad_r-(kw-1)*dilate_w, stride_w));
+        Label ic_tail_done;
         for (int ifm2 = 0; ifm2 < ic_blk; ifm2++) {
+            if (ic_tail && ifm2 == ic_tail) {
+                test(reg_ci_flag, FLAG_IC_LAST);
+                jnz(ic_tail_done, T_NEAR);
+            }
             for (int jj = jj_start; jj < jj_end; jj++) {
                 size_t inp_off;
                 if (one_of(jcp.src_tag, ncw, nchw, ncdhw))
                     inp_off = sizeof(float)*((size_t)ifm2*id*ih*iw
                         + (ki*dilate_w + jj*stride_w - pad_l));
                 else
-                    inp_off = sizeof(float)*((ki*dilate_w + jj*stride_w
-                                - pad_l)*ic_blk + ifm2);
+                    inp_off = sizeof(float)*((size_t)(ki*dilate_w + jj*stride_w
+                                - pad_l)*inp_mult + ifm2);
                 vbroadcastss(Ymm(oc_blocks * ur_w + jj),
                         make_safe_addr(aux_reg_input, inp_off, reg_long_offt));
             }
@@ -82,6 +102,7 @@ void jit_avx2_conv_fwd_kernel_f32::oh_step_unroll_kw(int ur_w,
                     }
             }
         }
+        L(ic_tail_done);
     }
 }
 
@@ -102,21 +123,29 @@ void jit_avx2_conv_fwd_kernel_f32::oh_step_nopad(int ur_w,
     int dilate_w = jcp.dilate_w + 1;
     int ic_blk = jcp.ic_block;
     int oc_blk = jcp.oc_block;
+    const int inp_mult = src_pixel_stride();
+    const int ic_tail = is_nxc(jcp.src_tag)
+        ? jcp.ic_without_padding % ic_blk : 0;
 
     xor_(ki_iter, ki_iter);
     L(kw_loop);
     {
         int jj_start = 0;
         int jj_end = ur_w;
+        Label ic_tail_done;
         for (int ifm2 = 0; ifm2 < ic_blk; ifm2++) {
+            if (ic_tail && ifm2 == ic_tail) {
+                test(reg_ci_flag, FLAG_IC_LAST);
+                jnz(ic_tail_done, T_NEAR);
+            }
             for (int jj = jj_start; jj < jj_end; jj++) {
                 size_t inp_off;
                 if (one_of(jcp.src_tag, ncw, nchw, ncdhw))
                     inp_off = sizeof(float)*((size_t)ifm2 * id * ih * iw
                             + (jj * stride_w - pad_l));
                 else
-                    inp_off = sizeof(float)*((jj * stride_w - pad_l) * ic_blk
-                            + ifm2);
+                    inp_off = sizeof(float)*((size_t)(jj * stride_w - pad_l)
+                            * inp_mult + ifm2);
                 vbroadcastss(Ymm(oc_blocks * ur_w + jj),
                     make_safe_addr(aux_reg_input, inp_off, reg_long_offt));
             }
@@ -135,9 +164,9 @@ void jit_avx2_conv_fwd_kernel_f32::oh_step_nopad(int ur_w,
                     }
             }
         }
+        L(ic_tail_done);
         add(aux_reg_kernel, sizeof(float) * oc_blk * ic_blk);
-        add(aux_reg_input, sizeof(float) * (one_of(jcp.src_tag, ncw, nchw, ncdhw)
-                ? dilate_w : ic_blk * dilate_w));
+        add(aux_reg_input, sizeof(float) * inp_mult * dilate_w);
 
         inc(ki_iter);
         cmp(ki_iter, kw);
@@ -158,10 +187,55 @@ void jit_avx2_conv_fwd_kernel_f32::width_blk_step(int ur_w,
     int dilate_w = jcp.dilate_w + 1;
     int ic_blk = jcp.ic_block;
     int oc_blk = jcp.oc_block;
-    const int inp_mult = one_of(jcp.src_tag, ncw, nchw, ncdhw)
-        ? 1 : ic_blk;
-    const int inp_off = one_of(jcp.src_tag, ncw, nchw, ncdhw)
-        ? dilate_w : ic_blk * dilate_w;
+    const int inp_mult = src_pixel_stride();
+    const int inp_off = inp_mult * dilate_w;
+    const bool dst_nxc = is_nxc(jcp.dst_tag);
+    const int oc_tail = dst_nxc ? jcp.oc_without_padding % oc_blk : 0;
+
+    auto output_offset = [&](int ii, int jj) {
+        return sizeof(float) * (dst_nxc
+                ? (size_t)ii * oc_blk + (size_t)jj * dst_pixel_stride()
+                : ((size_t)ii * od * oh * ow + jj) * oc_blk);
+    };
+
+    /* With a channel tail the last output block of the last oc_blocks chunk
+     * is only partially present in a non-blocked dst */
+    auto access_output = [&](bool is_store) {
+        auto access = [&](bool tail) {
+            if (tail) {
+                mov(imm_addr64, reinterpret_cast<size_t>(
+                            &tail_mask[oc_blk - oc_tail]));
+                vmovups(ymm15, ptr[imm_addr64]);
+            }
+            for (int ii = 0; ii < oc_blocks; ii++) {
+                for (int jj = 0; jj < ur_w; jj++) {
+                    Ymm reg_out = Ymm(ur_w * ii + jj);
+                    auto addr = make_safe_addr(reg_output,
+                            output_offset(ii, jj), reg_long_offt);
+                    if (tail && ii == oc_blocks - 1) {
+                        if (is_store) vmaskmovps(addr, ymm15, reg_out);
+                        else vmaskmovps(reg_out, ymm15, addr);
+                    } else {
+                        if (is_store) vmovups(addr, reg_out);
+                        else vmovups(reg_out, addr);
+                    }
+                }
+            }
+        };
+
+        if (oc_tail) {
+            Label tail, done;
+            test(reg_ci_flag, FLAG_OC_LAST);
+            jnz(tail, T_NEAR);
+            access(false);
+            jmp(done, T_NEAR);
+            L(tail);
+            access(true);
+            L(done);
+        } else {
+            access(false);
+        }
+    };
 
     Label init_done, init_first;
 
@@ -170,14 +244,7 @@ void jit_avx2_conv_fwd_kernel_f32::width_blk_step(int ur_w,
         jne(init_first, T_NEAR);
     }
 
-    for (int ii = 0; ii < oc_blocks; ii++) {
-        for (int jj = 0; jj < ur_w; jj++) {
-            size_t offt =
-                sizeof(float) * ((size_t)ii * od * oh * ow + jj) * oc_blk;
-            vmovups(Ymm(ur_w * ii + jj),
-                    make_safe_addr(reg_output, offt, reg_long_offt));
-        }
-    }
+    access_output(false);
 
     if (jcp.with_sum && jcp.with_bias) {
         test(reg_ci_flag, FLAG_IC_FIRST);
@@ -287,14 +354,7 @@ void jit_avx2_conv_fwd_kernel_f32::width_blk_step(int ur_w,
         L(regular_store);
     }
 
-    for (int ii = 0; ii < oc_blocks; ii++) {
-        for (int jj = 0; jj < ur_w; jj++) {
-            const size_t o_off
-                = sizeof(float) * ((size_t)ii * od * oh * ow + jj) * oc_blk;
-            Ymm reg_out = Ymm(ur_w * ii + jj);
-            vmovups(make_safe_addr(reg_output, o_off, reg_long_offt), reg_out);
-        }
-    }
+    access_output(true);
 }
 
 inline void jit_avx2_conv_fwd_kernel_f32::solve_common(
@@ -305,11 +365,11 @@ inline void jit_avx2_conv_fwd_kernel_f32::solve_common(
     int n_oi = jcp.ow / ur_w;
     int iw = jcp.iw;
     int kw = jcp.kw;
-    int ic_blk = jcp.ic_block;
     int oc_blk = jcp.oc_block;
     int dilate_w = jcp.dilate_w + 1;
     int str_w = jcp.stride_w;
-    const int inp_mult = one_of(jcp.src_tag, ncw, nchw, ncdhw) ? 1 : ic_blk;
+    const int inp_mult = src_pixel_stride();
+    const int out_mult = is_nxc(jcp.dst_tag) ? dst_pixel_stride() : oc_blk;
 
     int l_pad = jcp.l_pad;
     int r_pad = nstl::max(0, (int(jcp.ow) - 1) * str_w + (kw - 1) * dilate_w
@@ -327,7 +387,7 @@ inline void jit_avx2_conv_fwd_kernel_f32::solve_common(
             width_blk_step(ur_w, l_pad, 0,
                     'l', oc_blocks, oc_blocks_tag); // "lpad"
         add(reg_input, sizeof(float) * (ur_w * str_w - l_pad) * inp_mult);
-        add(reg_output, sizeof(float) * ur_w * oc_blk);
+        add(reg_output, sizeof(float) * ur_w * out_mult);
     }
 
     Label ow_loop;
@@ -339,7 +399,7 @@ inline void jit_avx2_conv_fwd_kernel_f32::solve_common(
         width_blk_step(ur_w, 0, 0,
                 'm', oc_blocks, oc_blocks_tag); // "middle"
         add(reg_input, sizeof(float) * ur_w * str_w * inp_mult);
-        add(reg_output, sizeof(float) * ur_w * oc_blk);
+        add(reg_output, sizeof(float) * ur_w * out_mult);
 
         inc(oi_iter);
         cmp(oi_iter, n_oi);
@@ -350,7 +410,7 @@ inline void jit_avx2_conv_fwd_kernel_f32::solve_common(
         width_blk_step(ur_w, 0, r_pad1,
                 'r', oc_blocks, oc_blocks_tag); // "rpad"
         add(reg_input, sizeof(float) * ur_w * str_w * inp_mult);
-        add(reg_output, sizeof(float) * ur_w * oc_blk);
+        add(reg_output, sizeof(float) * ur_w * out_mult);
     }
 
     if (ur_w_tail != 0)
@@ -437,6 +497,7 @@ status_t jit_avx2_conv_fwd_kernel_f32::init_conf(jit_conv_conf_t &jcp,
     jcp.oc = dst_d.dims()[1] / jcp.ngroups;
     jcp.oc_without_padding = jcp.oc;
     jcp.ic = src_d.dims()[1] / jcp.ngroups;
+    jcp.ic_without_padding = jcp.ic;
 
     jcp.id = (ndims == 5) ? src_d.dims()[2] : 1;
     jcp.ih = (ndims == 3) ? 1 : src_d.dims()[ndims-2];
@@ -466,17 +527,17 @@ status_t jit_avx2_conv_fwd_kernel_f32::init_conf(jit_conv_conf_t &jcp,
         jcp.src_tag = src_d.matches_one_of_tag(ncw, nwc, nCw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(
                 Owi8o, gOwi8o, OIw8i8o, gOIw8i8o);
-        jcp.dst_tag = dst_d.matches_one_of_tag(nCw8c);
+        jcp.dst_tag = dst_d.matches_one_of_tag(nwc, nCw8c);
     } else if (ndims == 4) {
         jcp.src_tag = src_d.matches_one_of_tag(nchw, nhwc, nChw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(
                 Ohwi8o, gOhwi8o, OIhw8i8o, gOIhw8i8o);
-        jcp.dst_tag = dst_d.matches_one_of_tag(nChw8c);
+        jcp.dst_tag = dst_d.matches_one_of_tag(nhwc, nChw8c);
     } else if (ndims == 5) {
         jcp.src_tag = src_d.matches_one_of_tag(ncdhw, ndhwc, nCdhw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(
                 Odhwi8o, gOdhwi8o, OIdhw8i8o, gOIdhw8i8o);
-        jcp.dst_tag = dst_d.matches_one_of_tag(nCdhw8c);
+        jcp.dst_tag = dst_d.matches_one_of_tag(ndhwc, nCdhw8c);
     }
     jcp.with_bias = cd.bias_desc.format_kind != format_kind::undef;
 
@@ -518,10 +579,11 @@ status_t jit_avx2_conv_fwd_kernel_f32::init_conf(jit_conv_conf_t &jcp,
                 && one_of(jcp.wei_tag, Owi8o, gOwi8o, Ohwi8o, gOhwi8o, Odhwi8o,
                     gOdhwi8o))
         && IMPLICATION(mimo, true
-                && one_of(jcp.src_tag, nCw8c, nChw8c, nCdhw8c)
+                && one_of(jcp.src_tag, nwc, nhwc, ndhwc, nCw8c, nChw8c,
+                    nCdhw8c)
                 && one_of(jcp.wei_tag, OIw8i8o, gOIw8i8o, OIhw8i8o, gOIhw8i8o,
                     OIdhw8i8o, gOIdhw8i8o))
-        && one_of(jcp.dst_tag, nCw8c, nChw8c, nCdhw8c);
+        && one_of(jcp.dst_tag, nwc, nhwc, ndhwc, nCw8c, nChw8c, nCdhw8c);
     if (!args_ok) return status::unimplemented;
 
     jcp.ur_h = 1; /* no code-unrolling by h so far */
@@ -615,6 +677,11 @@ void jit_avx2_conv_bwd_data_kernel_f32::compute_loop(int ur_w, int l_overflow,
     int nb_ic_block = jcp.nb_ic_blocking;
     int stride_w = jcp.stride_w;
     int stride_h = jcp.stride_h;
+    const int ddst_mult = diff_dst_pixel_stride();
+    const bool dsrc_nxc = is_nxc(jcp.src_tag);
+    const int oc_tail = is_nxc(jcp.dst_tag)
+        ? jcp.oc_without_padding % oc_block : 0;
+    const int ic_tail = dsrc_nxc ? jcp.ic_without_padding % ic_block : 0;
 
     Label kd_loop, skip_kd_loop;
     Label oc_loop, skip_oc_loop;
@@ -664,11 +731,17 @@ void jit_avx2_conv_bwd_data_kernel_f32::compute_loop(int ur_w, int l_overflow,
         for (int ki = 0; ki < kw; ki++) {
             int jj_start = get_iw_start(ki, l_overflow); // 0;
             int jj_end = get_iw_end(ur_w, ki, r_overflow); // ur_w;
+            Label oc_tail_done;
             for (int ofm2 = 0; ofm2 < jcp.oc_block; ofm2++) {
+                /* the driver reduces the channel tail in a call of its own */
+                if (oc_tail && ofm2 == oc_tail) {
+                    test(dword[param1 + GET_OFF(flags)], FLAG_OC_LAST);
+                    jnz(oc_tail_done, T_NEAR);
+                }
 
                 for (int jj = jj_start ; jj < jj_end; jj += stride_w) {
                     int aux_output_offset
-                      = (jj + jcp.l_pad - ki) / stride_w * jcp.oc_block + ofm2;
+                      = (jj + jcp.l_pad - ki) / stride_w * ddst_mult + ofm2;
                     vbroadcastss(Ymm(nb_ic_block * ur_w + jj / stride_w),
                             ptr[aux_reg_ddst
                             + sizeof(float) * aux_output_offset]);
@@ -687,10 +760,11 @@ void jit_avx2_conv_bwd_data_kernel_f32::compute_loop(int ur_w, int l_overflow,
                                 Ymm(nb_ic_block * ur_w + jj / stride_w), ymm15);
                 }
             }
+            L(oc_tail_done);
         }
         add(aux_reg_kernel, sizeof(float) * stride_h * kw  * oc_block
                                           * ic_block);
-        sub(aux_reg_ddst, sizeof(float) * ow * oc_block);
+        sub(aux_reg_ddst, sizeof(float) * ow * ddst_mult);
 
         dec(kj);
         cmp(kj, 0);
@@ -700,7 +774,7 @@ void jit_avx2_conv_bwd_data_kernel_f32::compute_loop(int ur_w, int l_overflow,
 
     if (jcp.ndims == 5) {
         sub(aux_reg_dst_d,
-                sizeof(float) * (jcp.dilate_d + 1) * jcp.oh * ow * ic_block);
+                sizeof(float) * (jcp.dilate_d + 1) * jcp.oh * ow * ddst_mult);
         add(aux_reg_ker_d,
                 sizeof(float) * jcp.kw * jcp.kh * oc_block * ic_block);
 
@@ -713,8 +787,8 @@ void jit_avx2_conv_bwd_data_kernel_f32::compute_loop(int ur_w, int l_overflow,
     }
 
     if (one_of(jcp.ndims, 3, 4)) {
-        int ddst_oc_shift = sizeof(float) * jcp.od * jcp.oh * jcp.ow
-                          * jcp.oc_block;
+        int ddst_oc_shift = sizeof(float) * jcp.oc_block
+                          * (is_nxc(jcp.dst_tag) ? 1 : jcp.od * jcp.oh * jcp.ow);
         int kernel_oc_shift = sizeof(float) * jcp.kd * jcp.kh * jcp.kw
                           * jcp.ic * jcp.oc_block;
 
@@ -729,29 +803,63 @@ void jit_avx2_conv_bwd_data_kernel_f32::compute_loop(int ur_w, int l_overflow,
         mov(reg_channel, ptr[param1 + GET_OFF(channel)]);
     }
 
-    Label no_update_label;
-    cmp(reg_channel, 0);
-    je(no_update_label, T_NEAR);
-    for (int ii = 0; ii < nb_ic_block; ii++) {
-        for (int jj = 0; jj < ur_w; jj++) {
-            size_t offt =
-                sizeof(float) * ((size_t)ii * id * ih * iw + jj) * ic_block;
-            vmovups(Ymm(15),
-                    make_safe_addr(reg_dsrc, offt, reg_long_offt));
-            vaddps(Ymm(ur_w * ii + jj), Ymm(ur_w * ii + jj),
-                    Ymm(15));
-
+    auto dsrc_offset = [&](int ii, int jj) {
+        return sizeof(float) * (dsrc_nxc
+                ? (size_t)ii * ic_block + (size_t)jj * diff_src_pixel_stride()
+                : ((size_t)ii * id * ih * iw + jj) * ic_block);
+    };
+
+    /* Ymm(14) is never an accumulator: at most 14 of them are used */
+    auto update_and_store = [&](bool tail) {
+        Ymm ymask = Ymm(14);
+        if (tail) {
+            mov(reg_long_offt, reinterpret_cast<size_t>(
+                        &tail_mask[ic_block - ic_tail]));
+            vmovups(ymask, ptr[reg_long_offt]);
         }
-    }
-    L(no_update_label);
+        auto masked = [&](int ii) { return tail && ii == nb_ic_block - 1; };
+
+        Label no_update_label;
+        cmp(reg_channel, 0);
+        je(no_update_label, T_NEAR);
+        for (int ii = 0; ii < nb_ic_block; ii++) {
+            for (int jj = 0; jj < ur_w; jj++) {
+                auto addr = make_safe_addr(reg_dsrc, dsrc_offset(ii, jj),
+                        reg_long_offt);
+                if (masked(ii))
+                    vmaskmovps(Ymm(15), ymask, addr);
+                else
+                    vmovups(Ymm(15), addr);
+                vaddps(Ymm(ur_w * ii + jj), Ymm(ur_w * ii + jj),
+                        Ymm(15));
 
-    for (int ii = 0; ii < nb_ic_block; ii++)
-        for (int jj = 0; jj < ur_w; jj++) {
-            size_t offt =
-                sizeof(float) * ((size_t)ii * id * ih * iw + jj) * ic_block;
-            vmovups(make_safe_addr(reg_dsrc, offt, reg_long_offt),
-                    Ymm(ur_w * ii + jj));
+            }
         }
+        L(no_update_label);
+
+        for (int ii = 0; ii < nb_ic_block; ii++)
+            for (int jj = 0; jj < ur_w; jj++) {
+                auto addr = make_safe_addr(reg_dsrc, dsrc_offset(ii, jj),
+                        reg_long_offt);
+                if (masked(ii))
+                    vmaskmovps(addr, ymask, Ymm(ur_w * ii + jj));
+                else
+                    vmovups(addr, Ymm(ur_w * ii + jj));
+            }
+    };
+
+    if (ic_tail) {
+        Label tail, done;
+        test(dword[param1 + GET_OFF(flags)], FLAG_IC_LAST);
+        jnz(tail, T_NEAR);
+        update_and_store(false);
+        jmp(done, T_NEAR);
+        L(tail);
+        update_and_store(true);
+        L(done);
+    } else {
+        update_and_store(false);
+    }
 }
 
 void jit_avx2_conv_bwd_data_kernel_f32::generate() {
@@ -764,8 +872,9 @@ void jit_avx2_conv_bwd_data_kernel_f32::generate() {
     mov(reg_channel, ptr[param1 + GET_OFF(channel)]);
     mov(reg_channel_work, ptr[param1 + GET_OFF(ch_blocks)]);
 
-    int ddst_shift = sizeof(float) * (jcp.ur_w / jcp.stride_w) * jcp.ic_block;
-    int dsrc_shift = sizeof(float) * jcp.ur_w * jcp.oc_block;
+    int ddst_shift = sizeof(float) * (jcp.ur_w / jcp.stride_w)
+        * diff_dst_pixel_stride();
+    int dsrc_shift = sizeof(float) * jcp.ur_w * diff_src_pixel_stride();
 
     int l_overflow = nstl::max(0, (jcp.kw - 1 - jcp.l_pad) / jcp.stride_w);
     int r_overflow = nstl::max(0, (jcp.kw - 1
@@ -836,6 +945,7 @@ status_t jit_avx2_conv_bwd_data_kernel_f32::init_conf(jit_conv_conf_t &jcp,
     jcp.oc = diff_dst_d.dims()[1] / jcp.ngroups;
     jcp.oc_without_padding = jcp.oc;
     jcp.ic = diff_src_d.dims()[1] / jcp.ngroups;
+    jcp.ic_without_padding = jcp.ic;
 
     jcp.id = (ndims == 5) ? diff_src_d.dims()[2] : 1;
     jcp.ih = (ndims == 3) ? 1 : diff_src_d.dims()[ndims-2];
@@ -897,24 +1007,24 @@ status_t jit_avx2_conv_bwd_data_kernel_f32::init_conf(jit_conv_conf_t &jcp,
         jcp.nb_oc_blocking = jcp.ow < 15 ? 4 : 2;
 
     if (ndims == 3) {
-        jcp.src_tag = diff_src_d.matches_one_of_tag(nCw8c);
+        jcp.src_tag = diff_src_d.matches_one_of_tag(nwc, nCw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(OIw8i8o, gOIw8o8i);
-        jcp.dst_tag = diff_dst_d.matches_one_of_tag(nCw8c);
+        jcp.dst_tag = diff_dst_d.matches_one_of_tag(nwc, nCw8c);
     } else if (ndims == 4) {
-        jcp.src_tag = diff_src_d.matches_one_of_tag(nChw8c);
+        jcp.src_tag = diff_src_d.matches_one_of_tag(nhwc, nChw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(OIhw8o8i, gOIhw8o8i);
-        jcp.dst_tag = diff_dst_d.matches_one_of_tag(nChw8c);
+        jcp.dst_tag = diff_dst_d.matches_one_of_tag(nhwc, nChw8c);
     } else if (ndims == 5) {
-        jcp.src_tag = diff_src_d.matches_one_of_tag(nCdhw8c);
+        jcp.src_tag = diff_src_d.matches_one_of_tag(ndhwc, nCdhw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(OIdhw8o8i, gOIdhw8o8i);
-        jcp.dst_tag = diff_dst_d.matches_one_of_tag(nCdhw8c);
+        jcp.dst_tag = diff_dst_d.matches_one_of_tag(ndhwc, nCdhw8c);
     }
 
     bool args_ok = true
-        && one_of(jcp.src_tag, nCw8c, nChw8c, nCdhw8c)
+        && one_of(jcp.src_tag, nwc, nhwc, ndhwc, nCw8c, nChw8c, nCdhw8c)
         && one_of(jcp.wei_tag, gOIw8o8i, OIw8i8o, gOIhw8o8i, OIhw8o8i,
                 gOIdhw8o8i, OIdhw8o8i)
-        && one_of(jcp.dst_tag, nCw8c, nChw8c, nCdhw8c)
+        && one_of(jcp.dst_tag, nwc, nhwc, ndhwc, nCw8c, nChw8c, nCdhw8c)
         && jcp.stride_w == jcp.stride_h
         && jcp.stride_d == 1
         && jcp.dilate_d == 0
@@ -96,6 +96,21 @@ private:
             char pad_label, int oc_blocks, char oc_blocks_label);
     inline void solve_common(int oc_blocks, char oc_blocks_label);
 
+    /* Distance in floats between neighbouring pixels of src and dst */
+    inline int src_pixel_stride() {
+        if (utils::one_of(jcp.src_tag, format_tag::ncw, format_tag::nchw,
+                    format_tag::ncdhw))
+            return 1;
+        return utils::one_of(jcp.src_tag, format_tag::nwc, format_tag::nhwc,
+                format_tag::ndhwc)
+            ? jcp.ngroups * jcp.ic_without_padding : jcp.ic_block;
+    }
+    inline int dst_pixel_stride() {
+        return utils::one_of(jcp.dst_tag, format_tag::nwc, format_tag::nhwc,
+                format_tag::ndhwc)
+            ? jcp.ngroups * jcp.oc_without_padding : jcp.oc_block;
+    }
+
     void generate();
 };
 
@@ -145,6 +160,18 @@ private:
 
     void generate();
 
+    /* Distance in floats between neighbouring pixels of diff_src/diff_dst */
+    inline int diff_src_pixel_stride() {
+        return utils::one_of(jcp.src_tag, format_tag::nwc, format_tag::nhwc,
+                format_tag::ndhwc)
+            ? jcp.ngroups * jcp.ic_without_padding : jcp.ic_block;
+    }
+    inline int diff_dst_pixel_stride() {
+        return utils::one_of(jcp.dst_tag, format_tag::nwc, format_tag::nhwc,
+                format_tag::ndhwc)
+            ? jcp.ngroups * jcp.oc_without_padding : jcp.oc_block;
+    }
+
     inline int get_iw_start(int ki, int l_overflow)
     {
         int res = (jcp.iw - 1 + jcp.r_pad) % jcp.stride_w
@@ -36,6 +36,13 @@ using namespace mkldnn::impl::utils;
     ? (f).blk_off(n, c, h, w) \
     : (f).blk_off(n, c, d, h, w)
 
+/* Non-blocked channels-last activations are addressed by channel, blocked
+ * ones by channel block */
+static bool is_nxc(format_tag_t tag) {
+    using namespace format_tag;
+    return utils::one_of(tag, nwc, nhwc, ndhwc);
+}
+
 #define wht_blk_off_(f, g, ...) \
     pd()->with_groups() ? (f).blk_off(g, __VA_ARGS__) : (f).blk_off(__VA_ARGS__)
 #define wht_blk_off(f, g, oc, ic, kd, kh, kw) \
@@ -95,6 +102,11 @@ void jit_avx2_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
 
                     const size_t _oc = g * jcp.nb_oc + ocb;
                     const size_t _ic = g * jcp.nb_ic * jcp.nonblk_group_off + icb;
+                    const size_t src_c = is_nxc(jcp.src_tag)
+                        ? g * jcp.ic + icb * jcp.ic_block
+                        : jcp.ic == 3 ? 0 : _ic;
+                    const size_t dst_c = is_nxc(jcp.dst_tag)
+                        ? g * jcp.oc + ocb * jcp.oc_block : _oc;
 
                     const int ih = nstl::max(ij - jcp.t_pad
                         + div_up(i_t_overflow,
@@ -104,10 +116,9 @@ void jit_avx2_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
                         + div_up(d_t_overflow,
                                  (jcp.dilate_d+1)) * (jcp.dilate_d + 1), 0);
 
-                    par_conv.src = &src[src_blk_off(src_d, n,
-                        jcp.ic == 3 ? 0 : _ic, id, ih, 0)];
+                    par_conv.src = &src[src_blk_off(src_d, n, src_c, id, ih, 0)];
 
-                    par_conv.dst = &dst[src_blk_off(dst_d, n, _oc, od, oh, 0)];
+                    par_conv.dst = &dst[src_blk_off(dst_d, n, dst_c, od, oh, 0)];
 
                     const int wh = div_up(i_t_overflow, (jcp.dilate_h + 1));
                     const int wd = div_up(d_t_overflow, (jcp.dilate_d + 1));
@@ -121,12 +132,14 @@ void jit_avx2_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
                         par_conv.flags |= FLAG_IC_FIRST;
                     }
 
-                    if (jcp.with_eltwise && icb + 1 == jcp.nb_ic) {
+                    if (icb + 1 == jcp.nb_ic) {
                         par_conv.flags |= FLAG_IC_LAST;
                     }
 
                     par_conv.oc_blocks =
                             nstl::min(ocb + ocb_num, jcp.nb_oc) - ocb;
+                    if (ocb + par_conv.oc_blocks == jcp.nb_oc)
+                        par_conv.flags |= FLAG_OC_LAST;
 
                     par_conv.kw_padding = 0;
                     const int kh_padding = jcp.kh
@@ -184,6 +197,17 @@ void jit_avx2_convolution_bwd_data_t::execute_backward_data(
         work_amount *= num_ih_blocks;
     }
 
+    /* The channel tail of a non-blocked diff_dst is reduced in a kernel call
+     * of its own */
+    const bool has_oc_tail = is_nxc(jcp.dst_tag)
+        && jcp.oc_without_padding % jcp.oc_block != 0;
+    auto oc_step = [&](int oc) {
+        int step = nstl::min(jcp.nb_oc - oc, jcp.nb_oc_blocking);
+        if (has_oc_tail && step > 1 && oc + step == jcp.nb_oc)
+            step--;
+        return step;
+    };
+
     auto ker = [&](const int ithr, const int nthr) {
         size_t start{0}, end{0};
         balance211(work_amount, nthr, ithr, start, end);
@@ -192,7 +216,7 @@ void jit_avx2_convolution_bwd_data_t::execute_backward_data(
         nd_iterator_init(start, n, jcp.mb, g, jcp.ngroups, icbb, icb_work,
                          ihb, num_ih_blocks);
         for (size_t iwork = start; iwork < end; ++iwork) {
-            for (int oc = 0; oc < jcp.nb_oc; oc += jcp.nb_oc_blocking)
+            for (int oc = 0; oc < jcp.nb_oc; oc += oc_step(oc))
             for (int id = 0; id < jcp.id; ++id) {
                 auto par_conv = jit_conv_call_s();
 
@@ -225,11 +249,19 @@ void jit_avx2_convolution_bwd_data_t::execute_backward_data(
                                    + i_b_overflow * jcp.stride_h;
                     const int oh = (ih + jcp.t_pad - k_lo) / jcp.stride_h;
 
+                    const int icb = jcp.nb_ic_blocking * icbb;
+                    const size_t diff_src_c = is_nxc(jcp.src_tag)
+                        ? g * jcp.ic + icb * jcp.ic_block
+                        : g * jcp.nb_ic + icb;
+                    const size_t diff_dst_c = is_nxc(jcp.dst_tag)
+                        ? g * jcp.oc + oc * jcp.oc_block
+                        : g * jcp.nb_oc + oc;
+
                     par_conv.src = &diff_src[src_blk_off(diff_src_d, n,
                         /*jcp.ic == 3 ? 0 :*/
-                        g * jcp.nb_ic + jcp.nb_ic_blocking * icbb, id, ih, 0)];
+                        diff_src_c, id, ih, 0)];
                     par_conv.dst = &diff_dst[src_blk_off(diff_dst_d,
-                            n, g * jcp.nb_oc + oc, od, oh, 0)];
+                            n, diff_dst_c, od, oh, 0)];
                     par_conv.filt = &weights[wht_blk_off(weights_d, g, oc,
                                 jcp.ic == 3 ? 0 : jcp.nb_ic_blocking * icbb,
                                 d_b_overflow, k_lo, 0)];
@@ -238,8 +270,12 @@ void jit_avx2_convolution_bwd_data_t::execute_backward_data(
                     par_conv.dst_prf = nullptr;
                     par_conv.filt_prf = nullptr;
                     par_conv.channel = oc;
-                    par_conv.ch_blocks = nstl::min(jcp.nb_oc - oc,
-                                       jcp.nb_oc_blocking);
+                    par_conv.ch_blocks = oc_step(oc);
+
+                    if (icb + jcp.nb_ic_blocking == jcp.nb_ic)
+                        par_conv.flags |= FLAG_IC_LAST;
+                    if (oc + par_conv.ch_blocks == jcp.nb_oc)
+                        par_conv.flags |= FLAG_OC_LAST;
 
                     kernel_->jit_ker(&par_conv);
                 }
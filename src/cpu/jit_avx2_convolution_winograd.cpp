@@ -0,0 +1,595 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <vector>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "gemm/gemm.hpp"
+#include "jit_generator.hpp"
+#include "jit_uni_eltwise.hpp"
+
+#include "jit_avx2_convolution_winograd.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+using namespace Xbyak;
+
+namespace {
+
+const int simd_w = 8;
+const int max_alpha = 8;
+const int wei_oc_chunk = 8; // oc blocks per weights transform buffer
+
+/* Toom-Cook matrices of F(m, r) for the points below plus the point at
+ * infinity: Y = A^T [(G g) . (B^T d)], following the construction in
+ * A. Lavin, S. Gray, "Fast Algorithms for Convolutional Neural Networks".
+ * AT is m x alpha, G is alpha x r and BT is alpha x alpha, row-major. */
+void wino_matrices(int m, int r, float *AT, float *G, float *BT) {
+    static const double points_m2[] = { 0., 1., -1. };
+    static const double points_m6[] = { 0., 1., -1., 2., -2., .5, -.5 };
+    const double *p = m == 2 ? points_m2 : points_m6;
+    const int alpha = m + r - 1;
+    const int n = alpha - 1; // number of finite points
+
+    /* coefficients of prod_{l != skip} (x - p_l), lowest degree first */
+    auto poly = [&](int skip, double *c) {
+        int deg = 0;
+        c[0] = 1.;
+        for (int l = 0; l < n; ++l) {
+            if (l == skip) continue;
+            c[deg + 1] = c[deg];
+            for (int k = deg; k > 0; --k)
+                c[k] = c[k - 1] - p[l] * c[k];
+            c[0] = -p[l] * c[0];
+            ++deg;
+        }
+    };
+
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double v = 1.;
+            for (int k = 0; k < i; ++k) v *= p[j];
+            AT[i * alpha + j] = (float)v;
+        }
+        AT[i * alpha + n] = i == m - 1 ? 1.f : 0.f;
+    }
+
+    for (int j = 0; j < n; ++j) {
+        double f = 1.;
+        for (int l = 0; l < n; ++l)
+            if (l != j) f *= p[j] - p[l];
+        double v = 1.;
+        for (int k = 0; k < r; ++k) {
+            G[j * r + k] = (float)(v / f);
+            v *= p[j];
+        }
+    }
+    for (int k = 0; k < r; ++k)
+        G[n * r + k] = k == r - 1 ? 1.f : 0.f;
+
+    double c[max_alpha + 1];
+    for (int j = 0; j <= n; ++j) {
+        for (int k = 0; k <= alpha; ++k) c[k] = 0.;
+        poly(j == n ? -1 : j, c);
+        for (int k = 0; k < alpha; ++k)
+            BT[j * alpha + k] = (float)c[k];
+    }
+}
+
+bool is_winograd_faster_than_direct(const jit_conv_conf_avx2_wino_t &jcp) {
+    /* the gemms have to be large enough to hide the cost of the transforms
+     * and the weights transform has to be amortized over enough tiles */
+    return jcp.ic >= 64 && jcp.oc >= 64 && jcp.ntiles >= 256
+        && jcp.nb_tile_block >= jcp.nthr;
+}
+
+}
+
+/* Computes dst = X src X^T for an n_in x n_in tile of 8-float vectors, where
+ * X is an n_out x n_in matrix known at generation time: zero coefficients
+ * are skipped and +-1 turn into additions. The column strides of the tiles
+ * are fixed, the row strides are passed at run time. The first pass stores
+ * src X^T in the workspace, the second one multiplies it by X. With
+ * post_ops the output transform also adds bias, sum and eltwise. */
+struct jit_avx2_wino_transform_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_avx2_wino_transform_t)
+
+    struct call_params_t {
+        const float *src;
+        float *dst;
+        float *wsp;
+        const float *bias;
+        size_t src_row_stride;
+        size_t dst_row_stride;
+    };
+    void (*ker_)(const call_params_t *);
+
+    jit_avx2_wino_transform_t(const jit_conv_conf_avx2_wino_t &ajcp,
+            int n_in, int n_out, const float *X, size_t src_col_stride,
+            size_t dst_col_stride, bool post_ops)
+        : jcp(ajcp), n_in_(n_in), n_out_(n_out), X_(X, X + n_in * n_out)
+        , src_col_stride_(src_col_stride), dst_col_stride_(dst_col_stride)
+        , post_ops_(post_ops), eltwise_injector_(nullptr)
+    {
+        assert(n_in_ <= max_alpha && n_out_ <= max_alpha);
+        if (post_ops_ && jcp.with_eltwise)
+            eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx2>(this,
+                    jcp.eltwise);
+
+        for (auto c : X_)
+            if (!one_of(c, 0.f, 1.f, -1.f) && coef_idx(c) < 0)
+                coefs_.push_back(c);
+
+        generate();
+        ker_ = reinterpret_cast<decltype(ker_)>(
+                const_cast<uint8_t *>(getCode()));
+    }
+
+    ~jit_avx2_wino_transform_t() { delete eltwise_injector_; }
+
+private:
+    const jit_conv_conf_avx2_wino_t jcp;
+    const int n_in_, n_out_;
+    const std::vector<float> X_;
+    const size_t src_col_stride_, dst_col_stride_;
+    const bool post_ops_;
+    std::vector<float> coefs_;
+    jit_uni_eltwise_injector_f32<avx2> *eltwise_injector_;
+
+    Reg64 reg_src = r8;
+    Reg64 reg_dst = r9;
+    Reg64 reg_wsp = r10;
+    Reg64 reg_src_stride = r11;
+    Reg64 reg_dst_stride = r12;
+    Reg64 reg_bias = r13;
+    Reg64 reg_coefs = r14;
+
+    Ymm vreg_acc(int i) { return Ymm(i); }
+    Ymm vreg_in = Ymm(8);
+    Ymm vreg_coef = Ymm(9);
+    Ymm vreg_sum_scale = Ymm(10);
+
+    Label l_coefs;
+
+    float X(int i, int j) const { return X_[i * n_in_ + j]; }
+
+    int coef_idx(float c) const {
+        for (size_t i = 0; i < coefs_.size(); ++i)
+            if (coefs_[i] == c) return (int)i;
+        return -1;
+    }
+
+    /* acc (+)= c * op, the first update of acc initializes it */
+    void fma(const Ymm &acc, float c, const Operand &op, bool &init) {
+        if (c == 0.f) return;
+        if (c == 1.f) {
+            if (init) vaddps(acc, acc, op);
+            else vmovups(acc, op);
+        } else if (c == -1.f) {
+            if (!init) vxorps(acc, acc, acc);
+            vsubps(acc, acc, op);
+        } else {
+            vbroadcastss(vreg_coef,
+                    ptr[reg_coefs + sizeof(float) * coef_idx(c)]);
+            if (init) vfmadd231ps(acc, vreg_coef, op);
+            else vmulps(acc, vreg_coef, op);
+        }
+        init = true;
+    }
+
+    void apply_post_ops() {
+        if (jcp.with_bias)
+            for (int j = 0; j < n_out_; ++j)
+                vaddps(vreg_acc(j), vreg_acc(j), ptr[reg_bias]);
+
+        if (jcp.with_sum) {
+            for (int j = 0; j < n_out_; ++j) {
+                auto dst = ptr[reg_dst + j * dst_col_stride_];
+                if (jcp.sum_scale == 1.f)
+                    vaddps(vreg_acc(j), vreg_acc(j), dst);
+                else
+                    vfmadd231ps(vreg_acc(j), vreg_sum_scale, dst);
+            }
+        }
+
+        if (jcp.with_eltwise)
+            eltwise_injector_->compute_vector_range(0, n_out_);
+    }
+
+    void generate();
+};
+
+void jit_avx2_wino_transform_t::generate() {
+    const int vlen = simd_w * sizeof(float);
+
+    preamble();
+
+#define READ_PARAM(reg, field) \
+        mov(reg, ptr[abi_param1 + offsetof(call_params_t, field)])
+    READ_PARAM(reg_src, src);
+    READ_PARAM(reg_dst, dst);
+    READ_PARAM(reg_wsp, wsp);
+    READ_PARAM(reg_src_stride, src_row_stride);
+    READ_PARAM(reg_dst_stride, dst_row_stride);
+    if (post_ops_ && jcp.with_bias)
+        READ_PARAM(reg_bias, bias);
+#undef READ_PARAM
+    mov(reg_coefs, l_coefs);
+
+    if (post_ops_ && jcp.with_sum && jcp.sum_scale != 1.f) {
+        mov(reg_dst_stride.cvt32(), float2int(jcp.sum_scale));
+        movd(Xmm(vreg_sum_scale.getIdx()), reg_dst_stride.cvt32());
+        vbroadcastss(vreg_sum_scale, Xmm(vreg_sum_scale.getIdx()));
+        mov(reg_dst_stride, ptr[abi_param1
+                + offsetof(call_params_t, dst_row_stride)]);
+    }
+
+    /* wsp[i][j] = sum_k src[i][k] * X[j][k] */
+    for (int i = 0; i < n_in_; ++i) {
+        bool init[max_alpha] = { false };
+        for (int k = 0; k < n_in_; ++k) {
+            vmovups(vreg_in, ptr[reg_src + k * src_col_stride_]);
+            for (int j = 0; j < n_out_; ++j)
+                fma(vreg_acc(j), X(j, k), vreg_in, init[j]);
+        }
+        for (int j = 0; j < n_out_; ++j) {
+            if (!init[j]) vxorps(vreg_acc(j), vreg_acc(j), vreg_acc(j));
+            vmovups(ptr[reg_wsp + (i * n_out_ + j) * vlen], vreg_acc(j));
+        }
+        if (i < n_in_ - 1) add(reg_src, reg_src_stride);
+    }
+
+    /* dst[i][j] = sum_k X[i][k] * wsp[k][j] */
+    for (int i = 0; i < n_out_; ++i) {
+        bool init[max_alpha] = { false };
+        for (int k = 0; k < n_in_; ++k)
+            for (int j = 0; j < n_out_; ++j)
+                fma(vreg_acc(j), X(i, k),
+                        ptr[reg_wsp + (k * n_out_ + j) * vlen], init[j]);
+        for (int j = 0; j < n_out_; ++j)
+            if (!init[j]) vxorps(vreg_acc(j), vreg_acc(j), vreg_acc(j));
+
+        if (post_ops_) apply_post_ops();
+
+        for (int j = 0; j < n_out_; ++j)
+            vmovups(ptr[reg_dst + j * dst_col_stride_], vreg_acc(j));
+        if (i < n_out_ - 1) add(reg_dst, reg_dst_stride);
+    }
+
+    postamble();
+
+    align(64);
+    L(l_coefs);
+    for (auto c : coefs_)
+        dd(float2int(c));
+
+    if (eltwise_injector_)
+        eltwise_injector_->prepare_table();
+}
+
+status_t jit_avx2_convolution_winograd_fwd_t::pd_t::init_conf() {
+    if (!mayiuse(avx2)) return status::unimplemented;
+
+    auto &jcp = jcp_;
+    const convolution_desc_t &cd = *desc();
+
+    jcp.prop_kind = cd.prop_kind;
+    jcp.r = 3;
+
+    jcp.mb = MB();
+    jcp.ic = rnd_up(IC(), simd_w);
+    jcp.oc_without_padding = OC();
+    jcp.oc = rnd_up(OC(), simd_w);
+    jcp.ih = IH();
+    jcp.iw = IW();
+    jcp.oh = OH();
+    jcp.ow = OW();
+    jcp.t_pad = padT();
+    jcp.l_pad = padL();
+
+    bool ok = true
+        && ndims() == 4
+        && !with_groups()
+        && KH() == jcp.r && KW() == jcp.r
+        && KSH() == 1 && KSW() == 1
+        && KDH() == 0 && KDW() == 0
+        && jcp.t_pad < jcp.r && jcp.l_pad < jcp.r
+        && padB() < jcp.r && padR() < jcp.r;
+    if (!ok) return status::unimplemented;
+
+    const auto &p = attr()->post_ops_;
+    auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
+    auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
+    switch (p.len_) {
+    case 0: ok = true; break;
+    case 1: ok = is_eltwise(0) || is_sum(0); break;
+    case 2: ok = is_sum(0) && is_eltwise(1); break;
+    default: ok = false;
+    }
+    if (!ok) return status::unimplemented;
+
+    jcp.with_bias = with_bias();
+    const int sum_ind = p.find(primitive_kind::sum);
+    jcp.with_sum = sum_ind != -1;
+    jcp.sum_scale = jcp.with_sum ? p.entry_[sum_ind].sum.scale : 1.f;
+    const int eltwise_ind = p.find(primitive_kind::eltwise);
+    jcp.with_eltwise = eltwise_ind != -1;
+    if (jcp.with_eltwise)
+        jcp.eltwise = p.entry_[eltwise_ind].eltwise;
+
+    jcp.ic_block = simd_w;
+    jcp.nb_ic = jcp.ic / jcp.ic_block;
+    jcp.oc_block = simd_w;
+    jcp.nb_oc = jcp.oc / jcp.oc_block;
+
+    /* F(6x6, 3x3) does 64 / 36 multiplications per output against 16 / 4
+     * for F(2x2, 3x3), but wastes more work on partial tiles */
+    auto n_mults = [&](int m) {
+        return div_up(jcp.oh, m) * div_up(jcp.ow, m) * (m + 2) * (m + 2);
+    };
+    jcp.m = n_mults(6) < n_mults(2) ? 6 : 2;
+    jcp.alpha = jcp.m + jcp.r - 1;
+
+    jcp.tiles_h = div_up(jcp.oh, jcp.m);
+    jcp.tiles_w = div_up(jcp.ow, jcp.m);
+    jcp.ntiles = jcp.mb * jcp.tiles_h * jcp.tiles_w;
+
+    /* Every tile block makes one pass over the transformed weights, which
+     * are alpha^2 / 9 times larger than the weights, so blocks are made as
+     * large as the per thread workspace allows. */
+    jcp.nthr = mkldnn_get_max_threads();
+    const size_t max_thr_wsp = 8 * 1024 * 1024;
+    const size_t tile_wsp
+        = sizeof(float) * jcp.alpha * jcp.alpha * (jcp.ic + jcp.oc);
+    jcp.tile_block = nstl::min(64, div_up(jcp.ntiles, jcp.nthr));
+    while (jcp.tile_block > 8 && jcp.tile_block * tile_wsp > max_thr_wsp)
+        jcp.tile_block /= 2;
+    jcp.nb_tile_block = div_up(jcp.ntiles, jcp.tile_block);
+
+    /* with auto the avx512 direct convolution is preferred when available */
+    if (cd.alg_kind == alg_kind::convolution_auto
+            && (mayiuse(avx512_common) || !is_winograd_faster_than_direct(jcp)))
+        return status::unimplemented;
+
+    return status::success;
+}
+
+void jit_avx2_convolution_winograd_fwd_t::pd_t::init_scratchpad() {
+    auto scratchpad = scratchpad_registry().registrar();
+    const auto &jcp = jcp_;
+    const size_t aa = jcp.alpha * jcp.alpha;
+
+    scratchpad.book(key_wino_U, sizeof(float) * aa * jcp.ic * jcp.oc, PAGE_4K);
+    scratchpad.book(key_wino_V, sizeof(float) * jcp.nthr * aa
+            * jcp.tile_block * jcp.ic, PAGE_4K);
+    scratchpad.book(key_wino_M, sizeof(float) * jcp.nthr * aa
+            * jcp.tile_block * jcp.oc, PAGE_4K);
+
+    if (wants_padded_bias())
+        scratchpad.book(key_conv_padded_bias, sizeof(float) * jcp.oc);
+}
+
+jit_avx2_convolution_winograd_fwd_t::jit_avx2_convolution_winograd_fwd_t(
+        const pd_t *apd)
+    : cpu_primitive_t(apd)
+{
+    const auto &jcp = pd()->jcp_;
+    const int alpha = jcp.alpha, m = jcp.m, r = jcp.r;
+
+    float AT[max_alpha * max_alpha], G[max_alpha * max_alpha],
+          BT[max_alpha * max_alpha];
+    wino_matrices(m, r, AT, G, BT);
+
+    /* V[alpha][alpha][tile][ic], U[alpha][alpha][ic][oc] and
+     * M[alpha][alpha][tile][oc], a vector holds 8 channels */
+    const size_t vlen = simd_w * sizeof(float);
+    const size_t V_stride = sizeof(float) * jcp.tile_block * jcp.ic;
+    const size_t M_stride = sizeof(float) * jcp.tile_block * jcp.oc;
+
+    src_trans_ = new jit_avx2_wino_transform_t(jcp, alpha, alpha, BT,
+            vlen, V_stride, false);
+    wei_trans_ = new jit_avx2_wino_transform_t(jcp, r, alpha, G,
+            vlen * jcp.ic_block, vlen * wei_oc_chunk, false);
+    dst_trans_ = new jit_avx2_wino_transform_t(jcp, alpha, m, AT,
+            M_stride, vlen, true);
+}
+
+jit_avx2_convolution_winograd_fwd_t::~jit_avx2_convolution_winograd_fwd_t() {
+    delete src_trans_;
+    delete wei_trans_;
+    delete dst_trans_;
+}
+
+void jit_avx2_convolution_winograd_fwd_t::execute_forward(
+        const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
+    auto weights = CTX_IN_MEM(const data_t *, MKLDNN_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const data_t *, MKLDNN_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DST);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper weights_d(pd()->weights_md(0));
+
+    const auto &jcp = pd()->jcp_;
+    auto scratchpad = this->scratchpad(ctx);
+
+    if (pd()->wants_padded_bias()) {
+        auto padded_bias = scratchpad.get<data_t>(key_conv_padded_bias);
+        utils::array_copy(padded_bias, bias, jcp.oc_without_padding);
+        utils::array_set(padded_bias + jcp.oc_without_padding, 0.f,
+                jcp.oc - jcp.oc_without_padding);
+        bias = padded_bias;
+    }
+
+    const int alpha = jcp.alpha, m = jcp.m, r = jcp.r;
+    const int aa = alpha * alpha;
+    const size_t U_stride = (size_t)jcp.ic * jcp.oc;
+    const size_t V_stride = (size_t)jcp.tile_block * jcp.ic;
+    const size_t M_stride = (size_t)jcp.tile_block * jcp.oc;
+
+    float *U = scratchpad.get<float>(key_wino_U);
+    float *V = scratchpad.get<float>(key_wino_V);
+    float *M = scratchpad.get<float>(key_wino_M);
+
+    /* U = G g G^T, a vector holds 8 oc of one ic. A chunk of oc is
+     * transformed into a local buffer first, so that U is written a row
+     * at a time rather than 32 bytes to each of the alpha x alpha planes. */
+    const int nb_oc_chunks = div_up(jcp.nb_oc, wei_oc_chunk);
+    parallel_nd(jcp.nb_ic, jcp.ic_block, nb_oc_chunks,
+            [&](int icb, int ic, int occ) {
+        float wsp[max_alpha * max_alpha * simd_w];
+        float buf[max_alpha * max_alpha * wei_oc_chunk * simd_w];
+        const int ocb_start = occ * wei_oc_chunk;
+        const int ocb_end = nstl::min(ocb_start + wei_oc_chunk, jcp.nb_oc);
+
+        jit_avx2_wino_transform_t::call_params_t p;
+        p.wsp = wsp;
+        p.bias = nullptr;
+        p.src_row_stride
+            = sizeof(float) * r * jcp.ic_block * jcp.oc_block;
+        p.dst_row_stride = sizeof(float) * alpha * wei_oc_chunk * simd_w;
+        for (int ocb = ocb_start; ocb < ocb_end; ++ocb) {
+            p.src = weights + weights_d.blk_off(ocb, icb) + ic * jcp.oc_block;
+            p.dst = buf + (ocb - ocb_start) * simd_w;
+            wei_trans_->ker_(&p);
+        }
+
+        const int oc_start = ocb_start * jcp.oc_block;
+        const int len = (ocb_end - ocb_start) * jcp.oc_block;
+        float *U_ic = U + (icb * jcp.ic_block + ic) * jcp.oc + oc_start;
+        for (int xi = 0; xi < aa; ++xi)
+            utils::array_copy(U_ic + xi * U_stride,
+                    buf + xi * wei_oc_chunk * simd_w, len);
+    });
+
+    auto tile_coords = [&](int tile, int &n, int &th, int &tw) {
+        tw = tile % jcp.tiles_w;
+        th = (tile / jcp.tiles_w) % jcp.tiles_h;
+        n = tile / (jcp.tiles_w * jcp.tiles_h);
+    };
+
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        int start{0}, end{0};
+        balance211(jcp.nb_tile_block, nthr, ithr, start, end);
+
+        float *V_thr = V + (size_t)ithr * aa * V_stride;
+        float *M_thr = M + (size_t)ithr * aa * M_stride;
+
+        float wsp[max_alpha * max_alpha * simd_w];
+        float tile_buf[max_alpha * max_alpha * simd_w];
+
+        jit_avx2_wino_transform_t::call_params_t p;
+        p.wsp = wsp;
+        p.bias = nullptr;
+
+        for (int tb = start; tb < end; ++tb) {
+            const int tile_start = tb * jcp.tile_block;
+            const int nt = nstl::min(jcp.tile_block, jcp.ntiles - tile_start);
+
+            /* V = B^T d B, tiles crossing the image border are gathered
+             * into a zero padded buffer first */
+            for (int t = 0; t < nt; ++t) {
+                int n, th, tw;
+                tile_coords(tile_start + t, n, th, tw);
+                const int ih_s = th * m - jcp.t_pad;
+                const int iw_s = tw * m - jcp.l_pad;
+                const bool inside = ih_s >= 0 && ih_s + alpha <= jcp.ih
+                    && iw_s >= 0 && iw_s + alpha <= jcp.iw;
+
+                for (int icb = 0; icb < jcp.nb_ic; ++icb) {
+                    if (inside) {
+                        p.src = src + src_d.blk_off(n, icb, ih_s, iw_s);
+                        p.src_row_stride = sizeof(float) * jcp.iw * simd_w;
+                    } else {
+                        for (int i = 0; i < alpha; ++i)
+                        for (int j = 0; j < alpha; ++j) {
+                            const int ih = ih_s + i, iw = iw_s + j;
+                            float *b = tile_buf + (i * alpha + j) * simd_w;
+                            const bool pad = ih < 0 || ih >= jcp.ih
+                                || iw < 0 || iw >= jcp.iw;
+                            const data_t *s = pad ? nullptr
+                                : src + src_d.blk_off(n, icb, ih, iw);
+                            PRAGMA_OMP_SIMD()
+                            for (int v = 0; v < simd_w; ++v)
+                                b[v] = pad ? 0.f : s[v];
+                        }
+                        p.src = tile_buf;
+                        p.src_row_stride = sizeof(float) * alpha * simd_w;
+                    }
+                    p.dst = V_thr + t * jcp.ic + icb * jcp.ic_block;
+                    p.dst_row_stride = sizeof(float) * alpha * V_stride;
+                    src_trans_->ker_(&p);
+                }
+            }
+
+            /* M = U V for each of the alpha x alpha points */
+            const float one = 1.f, zero = 0.f;
+            for (int xi = 0; xi < aa; ++xi)
+                extended_sgemm("N", "N", &jcp.oc, &nt, &jcp.ic, &one,
+                        U + xi * U_stride, &jcp.oc, V_thr + xi * V_stride,
+                        &jcp.ic, &zero, M_thr + xi * M_stride, &jcp.oc);
+
+            /* Y = A^T M A, partial tiles go through a buffer */
+            for (int t = 0; t < nt; ++t) {
+                int n, th, tw;
+                tile_coords(tile_start + t, n, th, tw);
+                const int oh_s = th * m, ow_s = tw * m;
+                const int h = nstl::min(m, jcp.oh - oh_s);
+                const int w = nstl::min(m, jcp.ow - ow_s);
+                const bool full = h == m && w == m;
+
+                for (int ocb = 0; ocb < jcp.nb_oc; ++ocb) {
+                    data_t *d = dst + dst_d.blk_off(n, ocb, oh_s, ow_s);
+                    const size_t d_row = (size_t)jcp.ow * simd_w;
+
+                    if (!full && jcp.with_sum)
+                        for (int i = 0; i < h; ++i)
+                            utils::array_copy(tile_buf + i * m * simd_w,
+                                    d + i * d_row, w * simd_w);
+
+                    p.src = M_thr + t * jcp.oc + ocb * jcp.oc_block;
+                    p.src_row_stride = sizeof(float) * alpha * M_stride;
+                    p.dst = full ? d : tile_buf;
+                    p.dst_row_stride = sizeof(float)
+                        * (full ? d_row : m * simd_w);
+                    p.bias = jcp.with_bias
+                        ? bias + ocb * jcp.oc_block : nullptr;
+                    dst_trans_->ker_(&p);
+
+                    if (!full)
+                        for (int i = 0; i < h; ++i)
+                            utils::array_copy(d + i * d_row,
+                                    tile_buf + i * m * simd_w, w * simd_w);
+                }
+            }
+        }
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
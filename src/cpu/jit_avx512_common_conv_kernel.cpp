@@ -134,7 +134,8 @@ void _jit_avx512_common_conv_fwd_kernel<Vmm>::store_output(int ur_w)
     }
 
     L(eltwise_label);
-    if (jcp.with_eltwise) {
+    /* with ic split among threads eltwise follows the driver's reduction */
+    if (jcp.with_eltwise && jcp.nthr_ic_b <= 1) {
         cmp(reg_channel, jcp.nb_ic - 1);
         jl(store_label, T_NEAR);
 
@@ -1597,6 +1598,18 @@ status_t jit_avx512_common_conv_fwd_kernel::init_conf(
         }
     }
 
+    /* Latency mode: when (mb, g, oc, oh, ow) gives fewer work items than
+     * threads, e.g. late stages at mb = 1, the ic blocks are split among
+     * groups of threads too. Each group but the first accumulates into its
+     * own copy of dst, the driver reduces the copies afterwards. */
+    jcp.nthr_ic_b = 1;
+    if (jcp.ndims == 4 && !jcp.is_1stconv && jcp.aligned_threads == 0) {
+        int work_amount = jcp.mb * jcp.ngroups
+            * (jcp.nb_oc / jcp.nb_oc_blocking) * jcp.oh * jcp.nb_ow;
+        if (work_amount < nthreads)
+            jcp.nthr_ic_b = nstl::min(jcp.nb_ic, nthreads / work_amount);
+    }
+
     return status::success;
 }
 
@@ -1604,6 +1617,10 @@ void jit_avx512_common_conv_fwd_kernel::init_scratchpad(
         memory_tracking::registrar_t &scratchpad, const jit_conv_conf_t &jcp) {
     if (jcp.with_bias && jcp.oc != jcp.oc_without_padding)
         scratchpad.book(key_conv_padded_bias, jcp.typesize_out * jcp.oc);
+    if (jcp.nthr_ic_b > 1)
+        scratchpad.book(key_conv_dst_reduction, jcp.typesize_out
+                * (jcp.nthr_ic_b - 1) * jcp.mb * jcp.ngroups * jcp.oc
+                * jcp.oh * jcp.ow);
 }
 
 void jit_avx512_common_conv_bwd_data_kernel_f32::prepare_output(int ur_w)
@@ -19,6 +19,8 @@
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
+#include "ref_eltwise.hpp"
+
 #include "jit_avx512_common_convolution.hpp"
 
 namespace mkldnn {
@@ -274,9 +276,36 @@ execute_forward_2d(const exec_ctx_t &ctx) const {
     else
         nthr = mkldnn_get_max_threads();
 
+    /* In latency mode the threads form nthr_ic groups, each one computing
+     * all the work items over its own range of ic blocks */
+    const int nthr_ic = jcp.nthr_ic_b;
+    const size_t dst_nelems = (size_t)jcp.mb * jcp.ngroups * jcp.oc * jcp.oh
+        * jcp.ow;
+    auto dst_reduction = nthr_ic > 1
+        ? scratchpad(ctx).template get<dst_data_t>(key_conv_dst_reduction)
+        : nullptr;
+
     parallel(nthr, [&](const int ithr, const int nthr) {
+        /* with fewer threads than ic groups, e.g. in a nested parallel
+         * region, a thread takes care of several groups */
+        const int nthr_grp = nstl::min(nthr_ic, nthr);
+        const int nthr_work = nthr / nthr_grp;
+        const int ithr_work = ithr / nthr_grp;
+        if (ithr_work >= nthr_work) return;
+
+        auto icb_begin = [&](int ithr_ic) {
+            int icb_start{0}, icb_end{0};
+            balance211(jcp.nb_ic, nthr_ic, ithr_ic, icb_start, icb_end);
+            return icb_start;
+        };
+        auto icb_finish = [&](int ithr_ic) {
+            int icb_start{0}, icb_end{0};
+            balance211(jcp.nb_ic, nthr_ic, ithr_ic, icb_start, icb_end);
+            return icb_end;
+        };
+
         int start{0}, end{0}, start_copy;
-        balance211(work_amount, nthr, ithr, start, end);
+        balance211(work_amount, nthr_work, ithr_work, start, end);
         start_copy = start;
 
         auto par_conv = jit_conv_call_s();
@@ -286,7 +315,15 @@ execute_forward_2d(const exec_ctx_t &ctx) const {
         size_t wht_h_stride = wht_blk_off(weights_d, 0, 0, 0, 1);
         size_t wht_ic_stride = wht_blk_off(weights_d, 0, 0, 1);
 
-        for (int icb_l2 = 0 ; icb_l2 < jcp.nb_ic; icb_l2 += jcp.nb_ic_L2) {
+        for (int ithr_ic = ithr % nthr_grp; ithr_ic < nthr_ic;
+                ithr_ic += nthr_grp)
+        for (int icb_l2 = icb_begin(ithr_ic); icb_l2 < icb_finish(ithr_ic);
+                icb_l2 += jcp.nb_ic_L2) {
+            const int icb_start = icb_begin(ithr_ic);
+            const int icb_end = icb_finish(ithr_ic);
+            dst_data_t *dst_ic = ithr_ic == 0
+                ? dst : dst_reduction + (ithr_ic - 1) * dst_nelems;
+
             start = start_copy;
             int n{0}, g{0}, occ{0}, oh_s{0}, owb{0};
 
@@ -312,17 +349,28 @@ execute_forward_2d(const exec_ctx_t &ctx) const {
                 int oh_e = oh_s + work_rem > jcp.oh ? jcp.oh : oh_s + work_rem;
                 auto bias_w = bias ? bias + g_oc : nullptr;
 
+                /* the partial sums of other ic groups start from zero, the
+                 * kernel accumulates into them since their icb is not 0 */
+                if (ithr_ic > 0 && icb_l2 == icb_start) {
+                    const int ow_e = nstl::min(jcp.ow, ow_s + jcp.ow_block);
+                    for (int oj = oh_s; oj < oh_e; ++oj)
+                    for (int k = 0; k < jcp.nb_oc_blocking; ++k)
+                        utils::array_set(dst_ic
+                                + dst_d.blk_off(n, g_ocb + k, oj, ow_s),
+                                (dst_data_t)0, (ow_e - ow_s) * jcp.oc_block);
+                }
+
                 for (int oh_b = oh_s; oh_b < oh_e; oh_b += jcp.h_blocking) {
                     int ih_b = -jcp.t_pad + oh_b * jcp.stride_h;
 
-                    auto dst_w = dst + dst_d.blk_off(n, g_ocb, oh_b, ow_s);
+                    auto dst_w = dst_ic + dst_d.blk_off(n, g_ocb, oh_b, ow_s);
                     auto src_w
                         = src + src_d.blk_off(n, g_icb + icb_l2, ih_b, iw_s);
                     auto wht_w
                             = weights + wht_blk_off(weights_d, g, ocb, icb_l2);
 
                     for (int icb = icb_l2;
-                            icb < min(jcp.nb_ic, icb_l2 + jcp.nb_ic_L2);
+                            icb < min(icb_end, icb_l2 + jcp.nb_ic_L2);
                             ++icb) {
                         auto src_c = src_w;
                         auto dst_c = dst_w;
@@ -370,6 +418,26 @@ execute_forward_2d(const exec_ctx_t &ctx) const {
         jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker, par_conv,
                 src, dst, weights, bias, 0, 0, 0);
     });
+
+    if (nthr_ic > 1) {
+        const auto &p = pd()->attr()->post_ops_;
+        const int eltwise_ind = p.find(primitive_kind::eltwise);
+        parallel(0, [&](const int ithr, const int nthr) {
+            size_t start{0}, end{0};
+            balance211(dst_nelems, nthr, ithr, start, end);
+            for (int r = 0; r < nthr_ic - 1; ++r) {
+                const dst_data_t *d_r = dst_reduction + r * dst_nelems;
+                PRAGMA_OMP_SIMD()
+                for (size_t i = start; i < end; ++i)
+                    dst[i] += d_r[i];
+            }
+            if (eltwise_ind != -1) {
+                ref_eltwise_scalar_fwd_t eltwise(p.entry_[eltwise_ind].eltwise);
+                for (size_t i = start; i < end; ++i)
+                    dst[i] = eltwise.compute_scalar(dst[i]);
+            }
+        });
+    }
 }
 
 template <data_type_t src_type, data_type_t wei_type,
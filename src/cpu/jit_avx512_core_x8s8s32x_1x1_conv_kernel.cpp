@@ -395,10 +395,12 @@ void jit_avx512_core_x8s8s32x_1x1_conv_kernel::generate()
 {
     preamble();
 
-    xor_(reg_scratch, reg_scratch);
-    Reg16 _t = reg_scratch.cvt16();
-    mov(_t, 0x1);
-    vpbroadcastw(zmm_one, _t);
+    if (jcp.ver != ver_vnni) {
+        xor_(reg_scratch, reg_scratch);
+        Reg16 _t = reg_scratch.cvt16();
+        mov(_t, 0x1);
+        vpbroadcastw(zmm_one, _t);
+    }
 
     sub(rsp, stack_space_needed);
 
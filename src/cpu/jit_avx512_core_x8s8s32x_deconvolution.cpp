@@ -713,10 +713,12 @@ void jit_avx512_core_x8s8s32x_deconv_fwd_kernel::icb_loop(
 void jit_avx512_core_x8s8s32x_deconv_fwd_kernel::generate() {
     preamble();
 
-    xor_(reg_scratch, reg_scratch);
-    Reg16 _t = reg_scratch.cvt16();
-    mov(_t, 0x1);
-    vpbroadcastw(zmm_one, _t);
+    if (!jcp.is_depthwise && jcp.ver != ver_vnni) {
+        xor_(reg_scratch, reg_scratch);
+        Reg16 _t = reg_scratch.cvt16();
+        mov(_t, 0x1);
+        vpbroadcastw(zmm_one, _t);
+    }
 
     if (jcp.ngroups % jcp.ch_block != 0 || jcp.oc_without_padding != jcp.oc) {
         int tail_size = jcp.is_depthwise ?
@@ -180,6 +180,33 @@ struct jit_conv_conf_2x3_wino_t {
     int nthr;
 };
 
+struct jit_conv_conf_avx2_wino_t {
+    prop_kind_t prop_kind;
+
+    int m;
+    int r;
+    int alpha;
+
+    int mb;
+    int ic, oc, oc_without_padding;
+    int ih, iw, oh, ow;
+    int l_pad, t_pad;
+
+    int nb_ic, ic_block;
+    int nb_oc, oc_block;
+
+    int tiles_h, tiles_w, ntiles;
+    int tile_block, nb_tile_block;
+
+    bool with_bias;
+    bool with_sum;
+    bool with_eltwise;
+    float sum_scale;
+    post_ops_t::entry_t::eltwise_t eltwise;
+
+    int nthr;
+};
+
 /*
    Winograd sched policy:
 
@@ -404,6 +431,7 @@ struct jit_gemm_conv_conf_t {
 
     int is, os, ks;
     int ic_block, oc_block;
+    int kh_block;
 
     int nthr;
     ptrdiff_t im2col_sz;
@@ -414,6 +442,31 @@ struct jit_gemm_conv_conf_t {
     bool outer_threading;
 };
 
+struct jit_fft_conv_conf_t {
+    prop_kind_t prop_kind;
+
+    int mb;
+    int ngroups, ic, oc;
+    int ih, iw, oh, ow;
+    int kh, kw;
+    int l_pad, t_pad;
+
+    int nh, nw; // fft sizes
+    int tile_h, tile_w; // outputs per tile
+    int nfreq;
+
+    int tiles_h, tiles_w, ntiles;
+    int tile_block, nb_tile_block;
+
+    bool with_bias;
+    bool with_sum;
+    bool with_eltwise;
+    float sum_scale;
+    post_ops_t::entry_t::eltwise_t eltwise;
+
+    int nthr;
+};
+
 struct jit_1x1_conv_call_s {
     const void *bcast_data;
     const void *load_data;
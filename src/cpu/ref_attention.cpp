@@ -0,0 +1,125 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+
+#include "ref_attention.hpp"
+#include "gemm/gemm.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace memory_tracking::names;
+
+void ref_attention_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
+    auto query = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC_QUERY);
+    auto key = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC_KEY);
+    auto value = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC_VALUE);
+    auto key_lengths = CTX_IN_MEM(const int32_t *, MKLDNN_ARG_SRC_KEY_LENGTHS);
+    auto dst = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DST);
+
+    auto scratchpad = this->scratchpad(ctx);
+    auto scores_base = scratchpad.get<float>(key_attention_scores);
+
+    const memory_desc_wrapper q_d(pd()->src_md(0));
+    const memory_desc_wrapper k_d(pd()->src_md(1));
+    const memory_desc_wrapper v_d(pd()->src_md(2));
+    const memory_desc_wrapper kl_d(pd()->src_md(3));
+    const memory_desc_wrapper dst_d(pd()->dst_md(0));
+
+    const int MB = pd()->MB();
+    const int Tq = pd()->Tq();
+    const int Tk = pd()->Tk();
+    const int C = pd()->C();
+    const int Cv = pd()->Cv();
+    const float scale = pd()->scale();
+
+    const auto &q_str = q_d.blocking_desc().strides;
+    const auto &k_str = k_d.blocking_desc().strides;
+    const auto &v_str = v_d.blocking_desc().strides;
+    const auto &dst_str = dst_d.blocking_desc().strides;
+    const int ldq = q_str[0], ldk = k_str[0], ldv = v_str[0];
+    const int ldd = dst_str[0];
+
+    query += q_d.offset0();
+    key += k_d.offset0();
+    value += v_d.offset0();
+    dst += dst_d.offset0();
+    if (key_lengths) key_lengths += kl_d.offset0();
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        int mb_start {0}, mb_end {0};
+        balance211(MB, nthr, ithr, mb_start, mb_end);
+
+        float *scores = scores_base + (size_t)ithr * Tk * Tq;
+
+        for (int mb = mb_start; mb < mb_end; mb++) {
+            const data_t *q = query + mb * q_str[1];
+            const data_t *k = key + mb * k_str[1];
+            const data_t *v = value + mb * v_str[1];
+            data_t *d = dst + mb * dst_str[1];
+
+            const int len = key_lengths
+                ? nstl::max(0, nstl::min(Tk, (int)key_lengths[mb])) : Tk;
+            if (len == 0) {
+                for (int t = 0; t < Tq; t++)
+                    for (int c = 0; c < Cv; c++)
+                        d[t * ldd + c] = 0.f;
+                continue;
+            }
+
+            // scores(j, i) = scale * k_j . q_i, for the valid keys only
+            const float beta = 0.f;
+            extended_sgemm("T", "N", &len, &Tq, &C, &scale, k, &ldk, q, &ldq,
+                    &beta, scores, &Tk);
+
+            // softmax over the keys of each query
+            for (int i = 0; i < Tq; i++) {
+                float *s = scores + i * Tk;
+                float smax = -FLT_MAX;
+                for (int j = 0; j < len; j++)
+                    smax = nstl::max(smax, s[j]);
+                float sum = 0.f;
+                for (int j = 0; j < len; j++) {
+                    s[j] = expf(s[j] - smax);
+                    sum += s[j];
+                }
+                const float rsum = 1.f / sum;
+                PRAGMA_OMP_SIMD()
+                for (int j = 0; j < len; j++)
+                    s[j] *= rsum;
+            }
+
+            // dst_i = sum_j scores(j, i) * v_j
+            const float one = 1.f;
+            extended_sgemm("N", "N", &Cv, &Tq, &len, &one, v, &ldv, scores,
+                    &Tk, &beta, d, &ldd);
+        }
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,117 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_REF_ATTENTION_HPP
+#define CPU_REF_ATTENTION_HPP
+
+#include <assert.h>
+#include <limits.h>
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_attention_pd.hpp"
+#include "cpu_primitive.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Scores and weighted sums are computed per minibatch entry with gemms on
+ * the strided Tx x C matrices of the inputs, so the tnc and ntc states of the
+ * RNN primitive are used in place. Keys past the length of a sequence are
+ * left out of both gemms, which masks them out of the softmax. */
+struct ref_attention_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_attention_fwd_pd_t {
+        using cpu_attention_fwd_pd_t::cpu_attention_fwd_pd_t;
+
+        DECLARE_COMMON_PD_T("ref:any", ref_attention_fwd_t);
+
+        status_t init() {
+            using namespace data_type;
+
+            bool ok = true
+                && is_fwd()
+                && desc()->alg_kind == alg_kind::attention_dot_product
+                && utils::everyone_is(f32, query_md_.data_type,
+                        key_md_.data_type, value_md_.data_type,
+                        dst_md_.data_type)
+                && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            if (set_default_formats() != status::success)
+                return status::unimplemented;
+
+            ok = true
+                && is_matrix_layout(query_md_)
+                && is_matrix_layout(key_md_)
+                && is_matrix_layout(value_md_)
+                && is_matrix_layout(dst_md_)
+                && IMPLICATION(with_key_lengths(),
+                        memory_desc_wrapper(key_lengths_md_).is_dense());
+            if (!ok) return status::unimplemented;
+
+            init_scratchpad();
+
+            return status::success;
+        }
+
+    private:
+        /* The channels are contiguous and the time and batch strides fit
+         * the leading dimension of a gemm. */
+        static bool is_matrix_layout(const memory_desc_t &md) {
+            const memory_desc_wrapper mdw(md);
+            if (!mdw.is_blocking_desc()) return false;
+            const auto &bd = mdw.blocking_desc();
+            return true
+                && bd.inner_nblks == 0
+                && (bd.strides[2] == 1 || md.dims[2] == 1)
+                && bd.strides[0] >= md.dims[2]
+                && bd.strides[0] <= INT_MAX
+                && bd.strides[1] <= INT_MAX;
+        }
+
+        void init_scratchpad() {
+            auto scratchpad = scratchpad_registry().registrar();
+            scratchpad.book(memory_tracking::names::key_attention_scores,
+                    sizeof(float) * mkldnn_get_max_threads() * Tk() * Tq());
+        }
+    };
+
+    ref_attention_fwd_t(const pd_t *apd): cpu_primitive_t(apd) {}
+
+    typedef prec_traits<data_type::f32>::type data_t;
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override {
+        execute_forward(ctx);
+        return status::success;
+    }
+
+private:
+    void execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -37,21 +37,53 @@ rnn_cell_execution_sig(
             1.0, w_iter_[0], rnn.weights_iter_ld, states_tm1_l_,
             rnn.states_ws_ld, 1.0, ws_gates_, rnn.gates_ws_ld);
 
-    rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
+    /* With a projection the hidden state is only an intermediate result, the
+     * state passed on is its projection */
+    src_data_t *ht_ = rnn.is_lstm_projection
+            ? reinterpret_cast<src_data_t *>(ws_cell_)
+            : states_t_l_;
+
+    rnn_postgemm_->execute(rnn, ws_gates_, ht_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], w_peephole_,
+            ws_grid_, ws_cell_);
+
+    if (rnn.is_lstm_projection)
+        lstm_projection(rnn, states_t_l_, w_projection_, ht_);
 }
 template rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution);
 template rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution);
 
+template <>
+void ref_rnn_fwd_f32_t::lstm_projection(const rnn_conf_t &rnn,
+        float *states_t_l_, const float *w_projection_,
+        const float *ht_) const {
+    gemm('N', 'N', rnn.dic, rnn.mb, rnn.dic, 1.0, w_projection_,
+            rnn.weights_projection_ld, ht_, rnn.states_ws_ld, 0.0,
+            states_t_l_, rnn.states_ws_ld);
+}
+
+template <>
+void ref_rnn_fwd_u8s8_t::lstm_projection(const rnn_conf_t &rnn,
+        src_data_t *states_t_l_, const weights_data_t *w_projection_,
+        const src_data_t *ht_) const {
+    assert(!"LSTM projection int8 is not supported");
+}
+
+template <>
+void ref_rnn_bwd_f32_t::lstm_projection(const rnn_conf_t &rnn,
+        float *states_t_l_, const float *w_projection_,
+        const float *ht_) const {
+    assert(!"LSTM projection backward is not supported");
+}
+
 template <>
 rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution) {
     ws_diff_states_aoc_t diff_states_t_l(rnn, diff_states_t_l_);
     rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], w_peephole_,
+            ws_grid_, ws_cell_);
 
     /// bwd by data on the cell
     (this->*gemm_iter_func)('N', 'N', rnn.sic, rnn.mb, rnn.n_gates * rnn.dic,
@@ -32,12 +32,10 @@ using namespace mkldnn::impl::math;
 using namespace rnn_utils;
 
 #define AOC array_offset_calculator
-template <>
-rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru) {
-    ws_gates_aoc_t ws_gates(rnn, ws_gates_);
-    bias_aoc_t bias(rnn, bias_[0]);
-    ws_states_aoc_t states_t_l(rnn, states_t_l_);
-    ws_states_aoc_t states_tm1_l(rnn, states_tm1_l_);
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
+rnn_cell_execution_sig((_ref_rnn_common_t<aprop, src_type,
+        weights_type>::cell_execution_gru)) {
+    ws_gates_aoc<acc_data_t> ws_gates(rnn, ws_gates_);
 
     // 1. gemm Wx[0-2],x
     if (!rnn.merge_gemm_layer) {
@@ -55,8 +53,8 @@ rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru) {
     // 3. activation zt and rt + elemwise multiplication rt,ht-1
     rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], w_peephole_,
+            ws_grid_, ws_cell_);
 
     // 4. gemm Wh[2],h~t
     (this->*gemm_iter_func)('N', 'N', rnn.dic, rnn.mb, rnn.sic, 1.0, w_iter_[1],
@@ -66,14 +64,12 @@ rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru) {
     // 5. activation h~t + calculate ht
     rnn_postgemm_->execute_part2(rnn, ws_gates_, states_t_l_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], w_peephole_,
+            ws_grid_, ws_cell_);
 }
 
-template <>
-rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution_gru) {
-    assert(!"GRU int8 is not supported");
-}
+template rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru);
+template rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution_gru);
 
 template <>
 rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru) {
@@ -95,8 +91,8 @@ rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru) {
     // 1. calculate dG2, dG1, and part of dht-1
     rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], w_peephole_,
+            ws_grid_, ws_cell_);
 
     // 2. calculate intermediate d(hG1)
     // d(hG1) = dG2 * W2h^t
@@ -107,8 +103,8 @@ rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru) {
     // 3. calculate dG1^ and part of dht-1
     rnn_postgemm_->execute_part2(rnn, ws_gates_, states_t_l_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], w_peephole_,
+            ws_grid_, ws_cell_);
 
     // 4. calculate diff weights
     // dWh1 += dG1 * h, dWh2 += dG2 * h, dWh3 += dG3 * (G1(*)h)
@@ -32,9 +32,9 @@ using namespace mkldnn::impl::math;
 using namespace rnn_utils;
 #define AOC array_offset_calculator
 
-
-template <>
-rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru_lbr) {
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
+rnn_cell_execution_sig((_ref_rnn_common_t<aprop, src_type,
+        weights_type>::cell_execution_gru_lbr)) {
     if (!rnn.merge_gemm_layer) {
         (this->*gemm_layer_func)('N', 'N', rnn.n_gates * rnn.dic, rnn.mb,
                 rnn.slc, 1.0, w_layer_[0], rnn.weights_layer_ld,
@@ -47,13 +47,11 @@ rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru_lbr) {
     rnn_postgemm_->execute(rnn, ws_gates_,
                 states_t_l_, c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
                 diff_states_t_l_, diff_states_t_lp1_, diff_states_tp1_l_,
-                bias_[0], ws_grid_, ws_cell_);
+                bias_[0], w_peephole_, ws_grid_, ws_cell_);
 }
 
-template <>
-rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution_gru_lbr) {
-    assert(!"GRU LBR int8 is not supported");
-}
+template rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru_lbr);
+template rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution_gru_lbr);
 
 
 template <>
@@ -64,7 +62,7 @@ rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru_lbr) {
     rnn_postgemm_->execute(rnn, ws_gates_,
                 states_t_l_, c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
                 diff_states_t_l_, diff_states_t_lp1_, diff_states_tp1_l_,
-                bias_[0], ws_grid_, ws_cell_);
+                bias_[0], w_peephole_, ws_grid_, ws_cell_);
 
     if (!rnn.merge_gemm_layer) {
         //  dx = dG * Wx^t
@@ -0,0 +1,119 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+/*
+ * Cell execution LSTM, gemms and elementwise fused per block of dic
+ */
+
+#include "math_utils.hpp"
+#include "mkldnn_thread.hpp"
+
+#include "ref_rnn.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::utils;
+using namespace mkldnn::impl::math;
+using namespace rnn_utils;
+
+/* A block of dic computes the four gates of its outputs with small gemms and
+ * applies the activations right away, while the gates are still in cache. */
+template <>
+void ref_rnn_fwd_f32_t::lstm_fused_block(const rnn_conf_t &rnn, int j_start,
+        int j_size, float *states_t_l_, float *c_states_t_l_,
+        float **w_layer_, float **w_iter_, float **bias_,
+        float *states_t_lm1_, float *states_tm1_l_, float *c_states_tm1_l_,
+        float *ws_gates_) const {
+    ws_gates_aoc_t ws_gates(rnn, ws_gates_);
+    bias_aoc_t bias(rnn, bias_[0]);
+    ws_states_aoc_t states_t_l(rnn, states_t_l_);
+    ws_states_aoc_t c_states_t_l(rnn, c_states_t_l_);
+    ws_states_aoc_t c_states_tm1_l(rnn, c_states_tm1_l_);
+
+    for (int g = 0; g < rnn.n_gates; g++) {
+        const int off = g * rnn.dic + j_start;
+        if (!rnn.merge_gemm_layer)
+            gemm('N', 'N', j_size, rnn.mb, rnn.slc, 1.0, w_layer_[0] + off,
+                    rnn.weights_layer_ld, states_t_lm1_, rnn.states_ws_ld,
+                    0.0, ws_gates_ + off, rnn.gates_ws_ld);
+        gemm('N', 'N', j_size, rnn.mb, rnn.sic, 1.0, w_iter_[0] + off,
+                rnn.weights_iter_ld, states_tm1_l_, rnn.states_ws_ld, 1.0,
+                ws_gates_ + off, rnn.gates_ws_ld);
+    }
+
+    for (int i = 0; i < rnn.mb; i++) {
+        PRAGMA_OMP_SIMD()
+        for (int j = j_start; j < j_start + j_size; j++) {
+            float G0 = logistic_fwd(ws_gates(i, 0, j) + bias(0, j));
+            float G1 = logistic_fwd(ws_gates(i, 1, j) + bias(1, j));
+            float G2 = tanh_fwd(ws_gates(i, 2, j) + bias(2, j));
+            float G3 = logistic_fwd(ws_gates(i, 3, j) + bias(3, j));
+
+            float tmp = G1 * c_states_tm1_l(i, j) + G0 * G2;
+            states_t_l(i, j) = G3 * tanh_fwd(tmp);
+            c_states_t_l(i, j) = tmp;
+        }
+    }
+}
+
+template <>
+void ref_rnn_fwd_u8s8_t::lstm_fused_block(const rnn_conf_t &rnn, int j_start,
+        int j_size, src_data_t *states_t_l_, float *c_states_t_l_,
+        weights_data_t **w_layer_, weights_data_t **w_iter_, float **bias_,
+        src_data_t *states_t_lm1_, src_data_t *states_tm1_l_,
+        float *c_states_tm1_l_, acc_data_t *ws_gates_) const {
+    assert(!"fused LSTM int8 is not supported");
+}
+
+template <>
+void ref_rnn_bwd_f32_t::lstm_fused_block(const rnn_conf_t &rnn, int j_start,
+        int j_size, float *states_t_l_, float *c_states_t_l_,
+        float **w_layer_, float **w_iter_, float **bias_,
+        float *states_t_lm1_, float *states_tm1_l_, float *c_states_tm1_l_,
+        float *ws_gates_) const {
+    assert(!"fused LSTM backward is not supported");
+}
+
+/* Blocks are independent, so they also give parallelism when mb is too small
+ * to split. */
+template <>
+rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_fused) {
+    const int nb_dic = div_up(rnn.dic, rnn.fused_dic_block);
+
+    parallel_nd(nb_dic, [&](int jb) {
+        const int j_start = jb * rnn.fused_dic_block;
+        const int j_size = nstl::min(rnn.fused_dic_block, rnn.dic - j_start);
+        lstm_fused_block(rnn, j_start, j_size, states_t_l_, c_states_t_l_,
+                w_layer_, w_iter_, bias_, states_t_lm1_, states_tm1_l_,
+                c_states_tm1_l_, ws_gates_);
+    });
+}
+
+template <>
+rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution_fused) {
+    assert(!"fused LSTM int8 is not supported");
+}
+
+template <>
+rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_fused) {
+    assert(!"fused LSTM backward is not supported");
+}
+
+}
+}
+}
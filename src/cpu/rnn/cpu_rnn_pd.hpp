@@ -47,6 +47,15 @@ protected:
             CHECK(memory_desc_init_by_tag(bias_md_, ldgo));
         if (with_dst_iter() && dst_iter_md_.format_kind == format_kind::any)
             CHECK(memory_desc_init_by_tag(dst_iter_md_, ldsnc));
+        if (with_peephole()
+                && weights_peephole_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_peephole_md_, ldgo));
+        if (with_projection()
+                && weights_projection_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_projection_md_, ldio));
+        if (with_seq_lengths()
+                && seq_lengths_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(seq_lengths_md_, x));
 
         return status::success;
     }
@@ -82,6 +91,12 @@ protected:
 
         ok = ok && IMPLICATION(!is_zero_md(&bias_md_),
                            memory_desc_matches_tag(bias_md_, ldgo));
+        ok = ok && IMPLICATION(!is_zero_md(&weights_peephole_md_),
+                           memory_desc_matches_tag(weights_peephole_md_, ldgo));
+        ok = ok && IMPLICATION(!is_zero_md(&weights_projection_md_),
+                memory_desc_matches_tag(weights_projection_md_, ldio));
+        ok = ok && IMPLICATION(!is_zero_md(&seq_lengths_md_),
+                memory_desc_matches_tag(seq_lengths_md_, x));
 
         /* Int8 is supported only for packed weights */
         data_type_t weights_iter_dt = weights_iter_md_.data_type;
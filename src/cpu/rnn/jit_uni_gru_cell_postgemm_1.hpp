@@ -59,10 +59,17 @@ protected:
     size_t hstate_dt_size = (src_data_t == data_type::u8) ? sizeof(uint8_t) : sizeof(float);
     size_t gate_dt_size = (src_data_t == data_type::u8) ? sizeof(uint32_t) : sizeof(float);
     size_t bias_dt_size = sizeof(float);
+    size_t qscale_dt_size = sizeof(float);
 
     void generate() {
         using namespace Xbyak;
 
+        const primitive_attr_t *attr = pd_->attr();
+        int mask = attr->rnn_weights_qparams_.mask_;
+        float *weights_scales = attr->rnn_weights_qparams_.scales_;
+        float data_scale = attr->rnn_data_qparams_.scale_;
+        float data_shift = attr->rnn_data_qparams_.shift_;
+
         // Labels declaration
         Label vector_loop_start_label, vector_loop_end_label;
         Label rem_loop_start_label, rem_loop_end_label;
@@ -71,9 +78,80 @@ protected:
         // Register map
         Reg64 loop_cnt(r11);  // loop counter
         Reg64 table_reg(rbx); // table is used for data scale and shifts
+        Reg64 tmp_reg(r12);   // used to load single u8 states
+        Reg64 weights_scales_reg(r13);
 
         // We skip vmm0 as it can be used by the injector for masks on sse4.1
-        Vmm G0(1), G1(2);
+        Vmm G0(1), G1(2), tmp1_vmm(3);
+
+        // constant table map
+        Address dscale_off_addr = ptr[table_reg];
+        Address dshift_off_addr = ptr[table_reg + vlen];
+        Address dscale_inv_off_addr = ptr[table_reg + 2*vlen];
+        Address ymm_perm_mask_addr = ptr[table_reg + 3*vlen];
+        Address zmm_perm_mask_addr = ptr[table_reg + 3*vlen + cpu_isa_traits<avx>::vlen];
+
+        // quantize from float to u8
+        auto q_d = [&](Vmm f, Vmm tmp_vmm) {
+            uni_vpxor(tmp_vmm, tmp_vmm, tmp_vmm);
+            uni_vmulps(f, f, dscale_off_addr); // apply scale
+            uni_vaddps(f, f, dshift_off_addr); // apply shift
+            uni_vcvtps2dq(f, f); // convert to int32
+            uni_vpackssdw(f, f, tmp_vmm); // convert from s32 to s16
+            uni_vpackuswb(f, f, tmp_vmm); // convert from s16 to u8 with saturation
+            // Note that the results are interleaved by 128 bit chunks, so we need to merge them together
+            switch (vlen) {
+            case 64:  { // Intel AVX-512
+                Zmm fz(f.getIdx()), tmpz(tmp_vmm.getIdx());
+                uni_vmovups(tmpz, zmm_perm_mask_addr);
+                vpermd(fz, tmpz, fz);
+                break; }
+            case 32: { // Intel AVX
+                Ymm fy(f.getIdx()), tmpy(tmp_vmm.getIdx());
+                uni_vmovups(tmpy, ymm_perm_mask_addr);
+                vpermd(fy, tmpy, fy);
+                break; }
+            case 16: // sse: nothing to do
+                break;
+            default: assert(!"Unsupported case");
+            };
+        };
+
+        // dequantize from u8 to float
+        auto deq_d = [&](Vmm s) {
+            uni_vcvtdq2ps(s, s);
+            uni_vsubps(s, s, dshift_off_addr);
+            uni_vmulps(s, s, dscale_inv_off_addr);
+        };
+
+        // dequantize from s32 to float
+        auto deq_w = [&](Vmm s, Vmm tmp, int gate, bool packed) {
+            if (mask == 0)
+                uni_vbroadcastss(tmp, ptr[weights_scales_reg]);
+            else if (packed)
+                uni_vmovups(tmp, ptr[weights_scales_reg + gate * rnn_.dic * qscale_dt_size]);
+            else
+                uni_vmovss(Xmm(tmp.getIdx()), ptr[weights_scales_reg + gate * rnn_.dic * qscale_dt_size]);
+            uni_vcvtdq2ps(s, s);
+            uni_vmulps(tmp, tmp, dscale_off_addr);
+            uni_vdivps(s, s, tmp);
+        };
+
+        // load u8 states and widen them to s32
+        auto load_u8 = [&](Vmm dst, const Address &addr) {
+            if (isa == sse41)
+                pmovzxbd(dst, addr);
+            else
+                vpmovzxbd(dst, addr);
+        };
+
+        auto load_u8_s = [&](Xmm dst, Reg64 addr_reg) {
+            movzx(tmp_reg.cvt32(), byte[addr_reg]);
+            if (isa == sse41)
+                movd(dst, tmp_reg.cvt32());
+            else
+                vmovd(dst, tmp_reg.cvt32());
+        };
 
         // We start code generations here
         preamble();
@@ -86,6 +164,7 @@ protected:
 
         // initialize registers with addresses and constants
         mov(table_reg, table_label);
+        mov(weights_scales_reg, size_t(weights_scales));
 
         // both sigmoid and tanh use the same table so load address just once in rax
         sigmoid_injector_->load_table_addr();
@@ -98,26 +177,46 @@ protected:
         {
             // Compute gate 0: G0 = sigmoid(G0 + b0)
             uni_vmovups(G0, ptr[addr_ws_gates_reg + 0 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8)
+                deq_w(G0, tmp1_vmm, 0, true);
             uni_vaddps(G0, G0, ptr[addr_bias_reg + 0 * rnn_.dic * bias_dt_size]);
             sigmoid_injector_->compute_vector(G0.getIdx());
-            // we store it for use in postgemm_part2
+            // we store it for use in postgemm_part2, as float even for int8
             uni_vmovups(ptr[addr_ws_gates_reg + 0 * rnn_.dic * gate_dt_size], G0);
 
             // Compute gate 1:  G1 = sigmoid(G1 + b1)
             uni_vmovups(G1, ptr[addr_ws_gates_reg + 1 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8)
+                deq_w(G1, tmp1_vmm, 1, true);
             uni_vaddps(G1, G1, ptr[addr_bias_reg + 1 * rnn_.dic * bias_dt_size]);
             sigmoid_injector_->compute_vector(G1.getIdx());
 
             // states_t_l = states_tm1_l * G1
-            uni_vmulps(G1, G1, ptr[addr_states_tm1_l_reg]);
-            uni_vmovups(ptr[addr_states_t_l_reg], G1);
+            if (src_data_t == data_type::u8) {
+                load_u8(tmp1_vmm, ptr[addr_states_tm1_l_reg]);
+                deq_d(tmp1_vmm);
+                uni_vmulps(G1, G1, tmp1_vmm);
+                q_d(G1, tmp1_vmm);
+                switch(vlen_dst){
+                case 16: uni_vmovups(ptr[addr_states_t_l_reg], Xmm(G1.getIdx())); break;
+                case 8: uni_vmovsd(ptr[addr_states_t_l_reg], Xmm(G1.getIdx())); break;
+                case 4: uni_vmovss(ptr[addr_states_t_l_reg], Xmm(G1.getIdx())); break;
+                default:
+                    assert(!"Unsuported vector length for quantization");
+                }
+            } else {
+                uni_vmulps(G1, G1, ptr[addr_states_tm1_l_reg]);
+                uni_vmovups(ptr[addr_states_t_l_reg], G1);
+            }
 
             // increment address pointers
             add(addr_ws_gates_reg, vlen);
             add(addr_bias_reg, vlen);
             add(addr_states_t_l_reg, vlen_dst);
             add(addr_states_tm1_l_reg, vlen_dst);
- 
+            if (src_data_t == data_type::u8 && mask != 0)
+                add(weights_scales_reg, vlen);
+
             // increment loop counter
             sub(loop_cnt, vlen);
             cmp(loop_cnt, vlen);
@@ -133,28 +232,43 @@ protected:
         {
             // remaping registers to Xmms
             Xmm G0s(G0.getIdx()), G1s(G1.getIdx());
+            Xmm tmp1s_vmm(tmp1_vmm.getIdx());
 
             // Compute gate 0:  G0 = sigmoid(G0 + b0)
             uni_vmovss(G0s, ptr[addr_ws_gates_reg + 0 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8)
+                deq_w(G0, tmp1_vmm, 0, false);
             uni_vaddss(G0s, G0s, ptr[addr_bias_reg + 0 * rnn_.dic * bias_dt_size]);
             sigmoid_injector_->compute_vector(G0s.getIdx());
-            // we store it for use in postgemm_part2
+            // we store it for use in postgemm_part2, as float even for int8
             uni_vmovss(ptr[addr_ws_gates_reg + 0 * rnn_.dic * gate_dt_size], G0s);
 
             // Compute gate 1: G1 = sigmoid(G1 + b1)
             uni_vmovss(G1s, ptr[addr_ws_gates_reg + 1 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8)
+                deq_w(G1, tmp1_vmm, 1, false);
             uni_vaddss(G1s, G1s, ptr[addr_bias_reg + 1 * rnn_.dic * bias_dt_size]);
             sigmoid_injector_->compute_vector(G1s.getIdx());
 
             // states_t_l = states_tm1_l * G1
-            uni_vmulss(G1s, G1s, ptr[addr_states_tm1_l_reg]);
-            uni_vmovss(ptr[addr_states_t_l_reg], G1s);
+            if (src_data_t == data_type::u8) {
+                load_u8_s(tmp1s_vmm, addr_states_tm1_l_reg);
+                deq_d(tmp1_vmm);
+                uni_vmulps(G1, G1, tmp1_vmm);
+                q_d(G1, tmp1_vmm);
+                pextrb(ptr[addr_states_t_l_reg], G1s, 0x0);
+            } else {
+                uni_vmulss(G1s, G1s, ptr[addr_states_tm1_l_reg]);
+                uni_vmovss(ptr[addr_states_t_l_reg], G1s);
+            }
 
             // increment address pointers
             add(addr_ws_gates_reg, gate_dt_size);
             add(addr_bias_reg, bias_dt_size);
             add(addr_states_t_l_reg, hstate_dt_size);
             add(addr_states_tm1_l_reg, hstate_dt_size);
+            if (src_data_t == data_type::u8 && mask != 0)
+                add(weights_scales_reg, qscale_dt_size);
 
             // increment loop counter
             sub(loop_cnt, gate_dt_size);
@@ -168,6 +282,18 @@ protected:
 
         // Again, only one table is needed and shared between sigmoid and tanh
         sigmoid_injector_->prepare_table(true);
+
+        L(table_label);
+        {
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(data_scale));
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(data_shift));
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(1.0f / data_scale));
+            // perm mask for ymm
+            dd(0); dd(4); dd(2); dd(3); dd(1); dd(5); dd(6); dd(7);
+            // perm mask for zmm
+            dd(0); dd(4); dd(8); dd(12); dd(1); dd(5); dd(6); dd(7);
+            dd(2); dd(9); dd(10); dd(11); dd(3); dd(12); dd(13); dd(14);
+        }
     }
 
 };
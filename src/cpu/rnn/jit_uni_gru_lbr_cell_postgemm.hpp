@@ -63,10 +63,17 @@ protected:
     size_t hstate_dt_size = (src_data_t == data_type::u8) ? sizeof(uint8_t) : sizeof(float);
     size_t gate_dt_size = (src_data_t == data_type::u8) ? sizeof(uint32_t) : sizeof(float);
     size_t bias_dt_size = sizeof(float);
+    size_t qscale_dt_size = sizeof(float);
 
     void generate() {
         using namespace Xbyak;
 
+        const primitive_attr_t *attr = pd_->attr();
+        int mask = attr->rnn_weights_qparams_.mask_;
+        float *weights_scales = attr->rnn_weights_qparams_.scales_;
+        float data_scale = attr->rnn_data_qparams_.scale_;
+        float data_shift = attr->rnn_data_qparams_.shift_;
+
         // Labels declaration
         Label vector_loop_start_label, vector_loop_end_label;
         Label rem_loop_start_label, rem_loop_end_label;
@@ -75,12 +82,81 @@ protected:
         // Register map
         Reg64 loop_cnt(r11);  // loop counter
         Reg64 table_reg(rbx); // table is used for data scale and shifts
+        Reg64 tmp_reg(r12);   // used to load single u8 states
+        Reg64 weights_scales_reg(r13);
 
         // We skip vmm0 as it can be used by the injector for masks on sse4.1
-        Vmm G0(1), G1(2), G2(3), tmp1_vmm(5);
+        Vmm G0(1), G1(2), G2(3), tmp1_vmm(5), tmp2_vmm(6);
 
         // constant table map
         Address one_addr = ptr[table_reg];
+        Address dscale_off_addr = ptr[table_reg + vlen];
+        Address dshift_off_addr = ptr[table_reg + 2*vlen];
+        Address dscale_inv_off_addr = ptr[table_reg + 3*vlen];
+        Address ymm_perm_mask_addr = ptr[table_reg + 4*vlen];
+        Address zmm_perm_mask_addr = ptr[table_reg + 4*vlen + cpu_isa_traits<avx>::vlen];
+
+        // quantize from float to u8
+        auto q_d = [&](Vmm f, Vmm tmp_vmm) {
+            uni_vpxor(tmp_vmm, tmp_vmm, tmp_vmm);
+            uni_vmulps(f, f, dscale_off_addr); // apply scale
+            uni_vaddps(f, f, dshift_off_addr); // apply shift
+            uni_vcvtps2dq(f, f); // convert to int32
+            uni_vpackssdw(f, f, tmp_vmm); // convert from s32 to s16
+            uni_vpackuswb(f, f, tmp_vmm); // convert from s16 to u8 with saturation
+            // Note that the results are interleaved by 128 bit chunks, so we need to merge them together
+            switch (vlen) {
+            case 64:  { // Intel AVX-512
+                Zmm fz(f.getIdx()), tmpz(tmp_vmm.getIdx());
+                uni_vmovups(tmpz, zmm_perm_mask_addr);
+                vpermd(fz, tmpz, fz);
+                break; }
+            case 32: { // Intel AVX
+                Ymm fy(f.getIdx()), tmpy(tmp_vmm.getIdx());
+                uni_vmovups(tmpy, ymm_perm_mask_addr);
+                vpermd(fy, tmpy, fy);
+                break; }
+            case 16: // sse: nothing to do
+                break;
+            default: assert(!"Unsupported case");
+            };
+        };
+
+        // dequantize from u8 to float
+        auto deq_d = [&](Vmm s) {
+            uni_vcvtdq2ps(s, s);
+            uni_vsubps(s, s, dshift_off_addr);
+            uni_vmulps(s, s, dscale_inv_off_addr);
+        };
+
+        // dequantize from s32 to float
+        auto deq_w = [&](Vmm s, Vmm tmp, int gate, bool packed) {
+            if (mask == 0)
+                uni_vbroadcastss(tmp, ptr[weights_scales_reg]);
+            else if (packed)
+                uni_vmovups(tmp, ptr[weights_scales_reg + gate * rnn_.dic * qscale_dt_size]);
+            else
+                uni_vmovss(Xmm(tmp.getIdx()), ptr[weights_scales_reg + gate * rnn_.dic * qscale_dt_size]);
+            uni_vcvtdq2ps(s, s);
+            uni_vmulps(tmp, tmp, dscale_off_addr);
+            uni_vdivps(s, s, tmp);
+        };
+
+        // load u8 states and widen them to s32
+        auto load_u8 = [&](Vmm dst, const Address &addr) {
+            if (isa == sse41)
+                pmovzxbd(dst, addr);
+            else
+                vpmovzxbd(dst, addr);
+        };
+
+        auto load_u8_s = [&](Xmm dst, Reg64 addr_reg) {
+            movzx(tmp_reg.cvt32(), byte[addr_reg]);
+            if (isa == sse41)
+                movd(dst, tmp_reg.cvt32());
+            else
+                vmovd(dst, tmp_reg.cvt32());
+        };
 
         // We start code generations here
         preamble();
@@ -102,6 +178,7 @@ protected:
 
         // initialize registers with addresses and constants
         mov(table_reg, table_label);
+        mov(weights_scales_reg, size_t(weights_scales));
 
         // both sigmoid and tanh use the same table so load address just once in rax
         sigmoid_injector_->load_table_addr();
@@ -114,39 +191,83 @@ protected:
         {
             // Compute gate 0
             uni_vmovups(G0, ptr[addr_ws_gates_reg + 0 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8) {
+                deq_w(G0, tmp1_vmm, 0, true);
+                uni_vmovups(tmp2_vmm, ptr[addr_ws_gemm_reg + 0 * rnn_.dic * gate_dt_size]);
+                deq_w(tmp2_vmm, tmp1_vmm, 0, true);
+                uni_vaddps(G0, G0, tmp2_vmm);
+            } else {
+                uni_vaddps(G0, G0, ptr[addr_ws_gemm_reg + 0 * rnn_.dic * gate_dt_size]);
+            }
             uni_vaddps(G0, G0, ptr[addr_bias_reg + 0 * rnn_.dic * bias_dt_size]);
-            uni_vaddps(G0, G0, ptr[addr_ws_gemm_reg + 0 * rnn_.dic * gate_dt_size]);
             sigmoid_injector_->compute_vector(G0.getIdx());
 
             // Compute gate 1
             uni_vmovups(G1, ptr[addr_ws_gates_reg + 1 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8) {
+                deq_w(G1, tmp1_vmm, 1, true);
+                uni_vmovups(tmp2_vmm, ptr[addr_ws_gemm_reg + 1 * rnn_.dic * gate_dt_size]);
+                deq_w(tmp2_vmm, tmp1_vmm, 1, true);
+                uni_vaddps(G1, G1, tmp2_vmm);
+            } else {
+                uni_vaddps(G1, G1, ptr[addr_ws_gemm_reg + 1 * rnn_.dic * gate_dt_size]);
+            }
             uni_vaddps(G1, G1, ptr[addr_bias_reg + 1 * rnn_.dic * bias_dt_size]);
-            uni_vaddps(G1, G1, ptr[addr_ws_gemm_reg + 1 * rnn_.dic * gate_dt_size]);
             sigmoid_injector_->compute_vector(G1.getIdx());
 
             // compute last gate
             uni_vmovups(G2, ptr[addr_ws_gemm_reg + 2 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8)
+                deq_w(G2, tmp1_vmm, 2, true);
             uni_vaddps(G2, G2, ptr[addr_bias_reg + 3 * rnn_.dic * bias_dt_size]);
-            uni_vfmadd213ps(G2, G1, ptr[addr_ws_gates_reg + 2 * rnn_.dic * gate_dt_size]); // G2 * G1 + gates2
+            if (src_data_t == data_type::u8) {
+                uni_vmovups(tmp2_vmm, ptr[addr_ws_gates_reg + 2 * rnn_.dic * gate_dt_size]);
+                deq_w(tmp2_vmm, tmp1_vmm, 2, true);
+                uni_vfmadd213ps(G2, G1, tmp2_vmm); // G2 * G1 + gates2
+            } else {
+                uni_vfmadd213ps(G2, G1, ptr[addr_ws_gates_reg + 2 * rnn_.dic * gate_dt_size]); // G2 * G1 + gates2
+            }
             uni_vaddps(G2, G2, ptr[addr_bias_reg + 2 * rnn_.dic * bias_dt_size]);
             tanh_injector_->compute_vector(G2.getIdx());
 
             // states_t_l = states_tm1_l * G0 + (1 - G0) * G2
             uni_vmovups(tmp1_vmm, one_addr);
             uni_vsubps(tmp1_vmm, tmp1_vmm, G0);
-            uni_vmulps(G0, G0, ptr[addr_states_tm1_l_reg]);
+            if (src_data_t == data_type::u8) {
+                load_u8(tmp2_vmm, ptr[addr_states_tm1_l_reg]);
+                deq_d(tmp2_vmm);
+                uni_vmulps(G0, G0, tmp2_vmm);
+            } else {
+                uni_vmulps(G0, G0, ptr[addr_states_tm1_l_reg]);
+            }
             uni_vfmadd231ps(G0, tmp1_vmm, G2);
 
+            // if int8, we quantize the resulting state
+            if (src_data_t == data_type::u8)
+                q_d(G0, tmp1_vmm);
+
             // write back the result
-            uni_vmovups(ptr[addr_states_t_l_reg], G0);
+            if(vlen_dst == vlen)
+                uni_vmovups(ptr[addr_states_t_l_reg], G0);
+            else
+                // we write only 1/4 of the register
+                switch(vlen_dst){
+                case 16: uni_vmovups(ptr[addr_states_t_l_reg], Xmm(G0.getIdx())); break;
+                case 8: uni_vmovsd(ptr[addr_states_t_l_reg], Xmm(G0.getIdx())); break;
+                case 4: uni_vmovss(ptr[addr_states_t_l_reg], Xmm(G0.getIdx())); break;
+                default:
+                    assert(!"Unsuported vector length for quantization");
+                }
 
             // increment address pointers
             add(addr_ws_gates_reg, vlen);
             add(addr_bias_reg, vlen);
             add(addr_states_t_l_reg, vlen_dst);
             add(addr_states_tm1_l_reg, vlen_dst);
-            add(addr_ws_gemm_reg, vlen_dst);
- 
+            add(addr_ws_gemm_reg, vlen);
+            if (src_data_t == data_type::u8 && mask != 0)
+                add(weights_scales_reg, vlen);
+
             // increment loop counter
             sub(loop_cnt, vlen);
             cmp(loop_cnt, vlen);
@@ -162,35 +283,72 @@ protected:
         {
             // remaping registers to Xmms
             Xmm G0s(G0.getIdx()), G1s(G1.getIdx()), G2s(G2.getIdx());
-            Xmm tmp1s_vmm(tmp1_vmm.getIdx());
+            Xmm tmp1s_vmm(tmp1_vmm.getIdx()), tmp2s_vmm(tmp2_vmm.getIdx());
 
             // Compute gate 0
             uni_vmovss(G0s, ptr[addr_ws_gates_reg + 0 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8) {
+                deq_w(G0, tmp1_vmm, 0, false);
+                uni_vmovss(tmp2s_vmm, ptr[addr_ws_gemm_reg + 0 * rnn_.dic * gate_dt_size]);
+                deq_w(tmp2_vmm, tmp1_vmm, 0, false);
+                uni_vaddss(G0s, G0s, tmp2s_vmm);
+            } else {
+                uni_vaddss(G0s, G0s, ptr[addr_ws_gemm_reg + 0 * rnn_.dic * gate_dt_size]);
+            }
             uni_vaddss(G0s, G0s, ptr[addr_bias_reg + 0 * rnn_.dic * bias_dt_size]);
-            uni_vaddss(G0s, G0s, ptr[addr_ws_gemm_reg + 0 * rnn_.dic * gate_dt_size]);
             sigmoid_injector_->compute_vector(G0s.getIdx());
 
             // Compute gate 1
             uni_vmovss(G1s, ptr[addr_ws_gates_reg + 1 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8) {
+                deq_w(G1, tmp1_vmm, 1, false);
+                uni_vmovss(tmp2s_vmm, ptr[addr_ws_gemm_reg + 1 * rnn_.dic * gate_dt_size]);
+                deq_w(tmp2_vmm, tmp1_vmm, 1, false);
+                uni_vaddss(G1s, G1s, tmp2s_vmm);
+            } else {
+                uni_vaddss(G1s, G1s, ptr[addr_ws_gemm_reg + 1 * rnn_.dic * gate_dt_size]);
+            }
             uni_vaddss(G1s, G1s, ptr[addr_bias_reg + 1 * rnn_.dic * bias_dt_size]);
-            uni_vaddss(G1s, G1s, ptr[addr_ws_gemm_reg + 1 * rnn_.dic * gate_dt_size]);
             sigmoid_injector_->compute_vector(G1s.getIdx());
 
             // compute last gate
             uni_vmovss(G2s, ptr[addr_ws_gemm_reg + 2 * rnn_.dic * gate_dt_size]);
+            if (src_data_t == data_type::u8)
+                deq_w(G2, tmp1_vmm, 2, false);
             uni_vaddss(G2s, G2s, ptr[addr_bias_reg + 3 * rnn_.dic * bias_dt_size]);
-            uni_vfmadd213ss(G2s, G1s, ptr[addr_ws_gates_reg + 2 * rnn_.dic * gate_dt_size]); // G2 * G1 + gates2
+            if (src_data_t == data_type::u8) {
+                uni_vmovss(tmp2s_vmm, ptr[addr_ws_gates_reg + 2 * rnn_.dic * gate_dt_size]);
+                deq_w(tmp2_vmm, tmp1_vmm, 2, false);
+                uni_vfmadd213ss(G2s, G1s, tmp2s_vmm); // G2 * G1 + gates2
+            } else {
+                uni_vfmadd213ss(G2s, G1s, ptr[addr_ws_gates_reg + 2 * rnn_.dic * gate_dt_size]); // G2 * G1 + gates2
+            }
             uni_vaddss(G2s, G2s, ptr[addr_bias_reg + 2 * rnn_.dic * bias_dt_size]);
             tanh_injector_->compute_vector(G2s.getIdx());
 
             // states_t_l = states_tm1_l * G0 + (1 - G0) * G2
             uni_vmovss(tmp1s_vmm, one_addr);
             uni_vsubss(tmp1s_vmm, tmp1_vmm, G0s);
-            uni_vmulss(G0s, G0s, ptr[addr_states_tm1_l_reg]);
+            if (src_data_t == data_type::u8) {
+                load_u8_s(tmp2s_vmm, addr_states_tm1_l_reg);
+                deq_d(tmp2_vmm);
+                uni_vmulss(G0s, G0s, tmp2s_vmm);
+            } else {
+                uni_vmulss(G0s, G0s, ptr[addr_states_tm1_l_reg]);
+            }
             uni_vfmadd231ss(G0s, tmp1s_vmm, G2s);
 
+            // if int8, we quantize the resulting state
+            if (src_data_t == data_type::u8)
+                q_d(G0, tmp1_vmm);
+
             // write back the result
-	    uni_vmovss(ptr[addr_states_t_l_reg], G0s);
+            switch(hstate_dt_size){
+            case 4: uni_vmovss(ptr[addr_states_t_l_reg], G0s); break;
+            case 1: pextrb(ptr[addr_states_t_l_reg], G0s, 0x0); break;
+            default:
+                assert(!"Unsuported vector length for quantization");
+            }
 
             // increment address pointers
             add(addr_ws_gates_reg, gate_dt_size);
@@ -198,6 +356,8 @@ protected:
             add(addr_states_t_l_reg, hstate_dt_size);
             add(addr_states_tm1_l_reg, hstate_dt_size);
             add(addr_ws_gemm_reg, gate_dt_size);
+            if (src_data_t == data_type::u8 && mask != 0)
+                add(weights_scales_reg, qscale_dt_size);
 
             // increment loop counter
             sub(loop_cnt, gate_dt_size);
@@ -216,6 +376,14 @@ protected:
         L(table_label);
         {
             for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(1.0f));
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(data_scale));
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(data_shift));
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(1.0f / data_scale));
+            // perm mask for ymm
+            dd(0); dd(4); dd(2); dd(3); dd(1); dd(5); dd(6); dd(7);
+            // perm mask for zmm
+            dd(0); dd(4); dd(8); dd(12); dd(1); dd(5); dd(6); dd(7);
+            dd(2); dd(9); dd(10); dd(11); dd(3); dd(12); dd(13); dd(14);
         }
     }
 
@@ -65,6 +65,7 @@ protected:
     size_t gate_dt_size = (src_data_t == data_type::u8) ? sizeof(uint32_t) : sizeof(float);
     size_t qscale_dt_size = sizeof(float);
     size_t bias_dt_size = sizeof(float);
+    size_t peephole_dt_size = sizeof(float);
 
     void generate() {
         using namespace Xbyak;
@@ -166,8 +167,12 @@ protected:
         // use rsp and offset it with the size of pushed registers in
         // preamble
         mov(addr_c_states_t_l_reg, ptr[rsp + get_size_of_abi_save_regs() + 40]);
+        auto addr_weights_peephole_reg = r12;
+        mov(addr_weights_peephole_reg,
+                ptr[rsp + get_size_of_abi_save_regs() + 48]);
 #else
         auto addr_c_states_t_l_reg = abi_param5;
+        auto addr_weights_peephole_reg = abi_param6;
 #endif
 
         // initialize registers with addresses and constants
@@ -202,11 +207,23 @@ protected:
             uni_vaddps(G2, G2, ptr[addr_bias_reg + 2 * rnn_.dic * bias_dt_size]);
             uni_vaddps(G3, G3, ptr[addr_bias_reg + 3 * rnn_.dic * bias_dt_size]);
 
+            // add the peephole connections of the input and forget gates
+            if (rnn_.is_lstm_peephole) {
+                uni_vmovups(tmp1_vmm, ptr[addr_c_states_tm1_l_reg]);
+                uni_vmovups(tmp2_vmm, ptr[addr_weights_peephole_reg
+                        + 0 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G0, tmp2_vmm, tmp1_vmm);
+                uni_vmovups(tmp2_vmm, ptr[addr_weights_peephole_reg
+                        + 1 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G1, tmp2_vmm, tmp1_vmm);
+            }
+
             // inject eltwise code
             sigmoid_injector_->compute_vector(G0.getIdx());
             sigmoid_injector_->compute_vector(G1.getIdx());
             tanh_injector_->compute_vector(G2.getIdx());
-            sigmoid_injector_->compute_vector(G3.getIdx());
+            if (!rnn_.is_lstm_peephole)
+                sigmoid_injector_->compute_vector(G3.getIdx());
 
             // compute c_states_t_l = G1 * c_tm1_l + G0 * G2
             uni_vmovups(tmp1_vmm, ptr[addr_c_states_tm1_l_reg]);
@@ -214,6 +231,14 @@ protected:
             uni_vfmadd231ps(tmp1_vmm, G0, G2);
             uni_vmovups(ptr[addr_c_states_t_l_reg], tmp1_vmm);
 
+            // the output gate peephole looks at the new cell state
+            if (rnn_.is_lstm_peephole) {
+                uni_vmovups(tmp2_vmm, ptr[addr_weights_peephole_reg
+                        + 2 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G3, tmp2_vmm, tmp1_vmm);
+                sigmoid_injector_->compute_vector(G3.getIdx());
+            }
+
             // states_t_l = G3 * tanh(c_states_t_l)
             tanh_injector_->compute_vector(tmp1_vmm.getIdx());
             uni_vmulps(tmp1_vmm, tmp1_vmm, G3);
@@ -238,6 +263,8 @@ protected:
             // increment address pointers
             add(addr_ws_gates_reg, vlen);
             add(addr_bias_reg, vlen);
+            if (rnn_.is_lstm_peephole)
+                add(addr_weights_peephole_reg, vlen);
             add(addr_states_t_l_reg, vlen_dst);
             add(addr_c_states_tm1_l_reg, vlen);
             add(addr_c_states_t_l_reg, vlen);
@@ -259,7 +286,7 @@ protected:
         {
             // remaping registers to Xmms
             Xmm G0s(G0.getIdx()), G1s(G1.getIdx()), G2s(G2.getIdx()), G3s(G3.getIdx());
-            Xmm tmp1s_vmm(tmp1_vmm.getIdx());
+            Xmm tmp1s_vmm(tmp1_vmm.getIdx()), tmp2s_vmm(tmp2_vmm.getIdx());
 
             // load G0 G1 G2 G3
             uni_vmovss(G0s, ptr[addr_ws_gates_reg + 0 * rnn_.dic * gate_dt_size]);
@@ -285,11 +312,23 @@ protected:
             uni_vmovss(tmp1s_vmm, ptr[addr_bias_reg + 3 * rnn_.dic * bias_dt_size]);
             uni_vaddps(G3s, G3s, tmp1s_vmm);
 
+            // add the peephole connections of the input and forget gates
+            if (rnn_.is_lstm_peephole) {
+                uni_vmovss(tmp1s_vmm, ptr[addr_c_states_tm1_l_reg]);
+                uni_vmovss(tmp2s_vmm, ptr[addr_weights_peephole_reg
+                        + 0 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G0s, tmp2s_vmm, tmp1s_vmm);
+                uni_vmovss(tmp2s_vmm, ptr[addr_weights_peephole_reg
+                        + 1 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G1s, tmp2s_vmm, tmp1s_vmm);
+            }
+
             // inject eltwise code
             sigmoid_injector_->compute_vector(G0s.getIdx());
             sigmoid_injector_->compute_vector(G1s.getIdx());
             tanh_injector_->compute_vector(G2s.getIdx());
-            sigmoid_injector_->compute_vector(G3s.getIdx());
+            if (!rnn_.is_lstm_peephole)
+                sigmoid_injector_->compute_vector(G3s.getIdx());
 
             // compute c_states_t_l = G1 * c_tm1_l + G0s * G2
             uni_vmovups(tmp1s_vmm, ptr[addr_c_states_tm1_l_reg]);
@@ -297,6 +336,14 @@ protected:
             uni_vfmadd231ps(tmp1s_vmm, G0s, G2s);
             uni_vmovss(ptr[addr_c_states_t_l_reg], tmp1s_vmm);
 
+            // the output gate peephole looks at the new cell state
+            if (rnn_.is_lstm_peephole) {
+                uni_vmovss(tmp2s_vmm, ptr[addr_weights_peephole_reg
+                        + 2 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G3s, tmp2s_vmm, tmp1s_vmm);
+                sigmoid_injector_->compute_vector(G3s.getIdx());
+            }
+
             // states_t_l = G3 * tanh(c_states_t_l)
             tanh_injector_->compute_vector(tmp1s_vmm.getIdx());
             uni_vmulps(tmp1s_vmm, tmp1s_vmm, G3s);
@@ -316,6 +363,8 @@ protected:
             // increment address pointers
             add(addr_ws_gates_reg, gate_dt_size);
             add(addr_bias_reg, bias_dt_size);
+            if (rnn_.is_lstm_peephole)
+                add(addr_weights_peephole_reg, peephole_dt_size);
             add(addr_states_t_l_reg, hstate_dt_size);
             add(addr_c_states_tm1_l_reg, cstate_dt_size);
             add(addr_c_states_t_l_reg, cstate_dt_size);
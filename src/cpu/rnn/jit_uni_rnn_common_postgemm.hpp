@@ -36,7 +36,7 @@ namespace cpu {
 struct jit_uni_rnn_postgemm : public jit_generator {
 
     typedef void (*kernel_t)(void *param1_, const void *param2_, void *param3_,
-            void *param4_, void *param5_);
+            void *param4_, void *param5_, const void *param6_);
 
     jit_uni_rnn_postgemm(const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd): rnn_(rnn), pd_(pd){}
 
@@ -59,10 +59,12 @@ template <typename src_data_t, typename acc_data_t>
                 const void *param2_ = &bias(0, 0);  // RNN, LSTM, GRU
                 void *param3_ = &states_t_l(i, 0);  // RNN, LSTM, GRU
                 void *param4_, *param5_;
+                const void *param6_ = nullptr;
                 switch(pd_->cell_kind()){
                 case alg_kind::vanilla_lstm:
                     param4_ = &c_states_tm1_l(i, 0);
                     param5_ = &c_states_t_l(i, 0);
+                    param6_ = weights_peephole_;
                     break;
                 case alg_kind::gru_linear_before_reset:
                     param4_ = &states_tm1_l(i, 0);
@@ -77,7 +79,7 @@ template <typename src_data_t, typename acc_data_t>
                     param5_ = nullptr;
                     break;
                 }
-                kernel_(param1_, param2_, param3_, param4_, param5_);
+                kernel_(param1_, param2_, param3_, param4_, param5_, param6_);
             });
     }
 
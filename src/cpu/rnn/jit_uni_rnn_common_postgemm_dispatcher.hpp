@@ -39,7 +39,7 @@ template<prop_kind_t aprop, impl::data_type_t src_type>
 struct rnn_postgemm_dispatcher {
 
     typedef typename prec_traits<src_type>::type src_data_t;
-    typedef typename utils::conditional<src_type == data_type::u8, int32_t,
+    typedef typename utils::conditional<src_type == mkldnn_u8, int32_t,
             float>::type acc_data_t;
 
     using class_name = rnn_postgemm_dispatcher<aprop, src_type>;
@@ -175,13 +175,13 @@ struct rnn_postgemm_dispatcher {
     if (rnn_postgemm_)
         rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-                diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                diff_states_t_lp1_, diff_states_tp1_l_, bias_,
+                weights_peephole_, ws_grid_, ws_cell_);
     else
         (this->*postgemm_func)(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-                diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                diff_states_t_lp1_, diff_states_tp1_l_, bias_,
+                weights_peephole_, ws_grid_, ws_cell_);
 }
 
 // template <typename src_data_t, typename acc_data_t>
@@ -189,13 +189,13 @@ struct rnn_postgemm_dispatcher {
     if(rnn_postgemm_part2_)
         rnn_postgemm_part2_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-                diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                diff_states_t_lp1_, diff_states_tp1_l_, bias_,
+                weights_peephole_, ws_grid_, ws_cell_);
     else
         (this->*postgemm_part2_func)(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
-                diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                diff_states_t_lp1_, diff_states_tp1_l_, bias_,
+                weights_peephole_, ws_grid_, ws_cell_);
 }
 
 
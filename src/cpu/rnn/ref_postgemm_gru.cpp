@@ -21,6 +21,7 @@
 #include "math_utils.hpp"
 #include "mkldnn_thread.hpp"
 
+#include "../simple_q10n.hpp"
 #include "jit_uni_rnn_common_postgemm_dispatcher.hpp"
 
 namespace mkldnn {
@@ -66,14 +67,88 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::gru_part2_postgemm) {
     });
 }
 
+/* The int8 GRU keeps the states quantized between the two parts: part 1
+ * writes the quantized G1 * h_{t-1} that feeds the second iter gemm, and
+ * stores G0 as float in place of its s32 accumulator for part 2 */
 template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::gru_part1_postgemm) {
-    assert(!"GRU int8 is not supported");
+    ws_gates_aoc_s32_t ws_gates_s32(rnn, ws_gates_);
+    ws_gates_aoc_t ws_gates(rnn, reinterpret_cast<float *>(ws_gates_));
+    bias_aoc_t bias(rnn, bias_);
+    ws_states_aoc_u8_t states_t_l(rnn, states_t_l_);
+    ws_states_aoc_u8_t states_tm1_l(rnn, states_tm1_l_);
+
+    float *weights_scales = pd_->attr()->rnn_weights_qparams_.scales_;
+    float data_shift = pd_->attr()->rnn_data_qparams_.shift_;
+    float data_scale = pd_->attr()->rnn_data_qparams_.scale_;
+
+    auto q_d = [&](float f) {
+        float qf = f * data_scale + data_shift;
+        return qz_a1b0<float, src_data_t>()(qf);
+    };
+
+    auto deq_d = [&](src_data_t s) {
+        return ((float)s - data_shift) * (1.f / data_scale);
+    };
+
+    auto deq_w = [&](acc_data_t s, int gate, int j) {
+        return pd_->attr()->rnn_weights_qparams_.mask_ == 0 ?
+                saturate<float>(s) * (1.f / (weights_scales[0] * data_scale)) :
+                saturate<float>(s) * (1.f / (weights_scales[gate * rnn.dic + j]
+                                                   * data_scale));
+    };
+
+    parallel_nd(rnn.mb, [&](int i) {
+        PRAGMA_OMP_SIMD()
+        for (int j = 0; j < rnn.dic; j++) {
+            float G0 = logistic_fwd<float>(
+                    deq_w(ws_gates_s32(i, 0, j), 0, j) + bias(0, j));
+            float G1 = logistic_fwd<float>(
+                    deq_w(ws_gates_s32(i, 1, j), 1, j) + bias(1, j));
+            ws_gates(i, 0, j) = G0;
+            states_t_l(i, j) = q_d(deq_d(states_tm1_l(i, j)) * G1);
+        }
+    });
 }
 
 template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::gru_part2_postgemm) {
-    assert(!"GRU int8 is not supported");
+    ws_gates_aoc_s32_t ws_gates_s32(rnn, ws_gates_);
+    ws_gates_aoc_t ws_gates(rnn, reinterpret_cast<float *>(ws_gates_));
+    bias_aoc_t bias(rnn, bias_);
+    ws_states_aoc_u8_t states_t_l(rnn, states_t_l_);
+    ws_states_aoc_u8_t states_tm1_l(rnn, states_tm1_l_);
+
+    float *weights_scales = pd_->attr()->rnn_weights_qparams_.scales_;
+    float data_shift = pd_->attr()->rnn_data_qparams_.shift_;
+    float data_scale = pd_->attr()->rnn_data_qparams_.scale_;
+
+    auto q_d = [&](float f) {
+        float qf = f * data_scale + data_shift;
+        return qz_a1b0<float, src_data_t>()(qf);
+    };
+
+    auto deq_d = [&](src_data_t s) {
+        return ((float)s - data_shift) * (1.f / data_scale);
+    };
+
+    auto deq_w = [&](acc_data_t s, int gate, int j) {
+        return pd_->attr()->rnn_weights_qparams_.mask_ == 0 ?
+                saturate<float>(s) * (1.f / (weights_scales[0] * data_scale)) :
+                saturate<float>(s) * (1.f / (weights_scales[gate * rnn.dic + j]
+                                                   * data_scale));
+    };
+
+    parallel_nd(rnn.mb, [&](int i) {
+        PRAGMA_OMP_SIMD()
+        for (int j = 0; j < rnn.dic; j++) {
+            float G0 = ws_gates(i, 0, j);
+            float G2 = tanh_fwd<float>(
+                    deq_w(ws_gates_s32(i, 2, j), 2, j) + bias(2, j));
+            states_t_l(i, j) = q_d(
+                    deq_d(states_tm1_l(i, j)) * G0 + (1.0f - G0) * G2);
+        }
+    });
 }
 
 template <>
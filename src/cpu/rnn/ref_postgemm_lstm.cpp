@@ -36,6 +36,7 @@ template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::lstm_postgemm) {
     ws_gates_aoc_t ws_gates(rnn, ws_gates_);
     bias_aoc_t bias(rnn, bias_);
+    weights_peephole_aoc_t weights_peephole(rnn, weights_peephole_);
     ws_states_aoc_t states_t_l(rnn, states_t_l_);
     ws_states_aoc_t c_states_t_l(rnn, c_states_t_l_);
     ws_states_aoc_t c_states_tm1_l(rnn, c_states_tm1_l_);
@@ -43,13 +44,25 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::lstm_postgemm) {
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
-            ws_gates(i, 0, j) = logistic_fwd(ws_gates(i, 0, j) + bias(0, j));
-            ws_gates(i, 1, j) = logistic_fwd(ws_gates(i, 1, j) + bias(1, j));
+            float G0 = ws_gates(i, 0, j) + bias(0, j);
+            float G1 = ws_gates(i, 1, j) + bias(1, j);
+            if (rnn.is_lstm_peephole) {
+                G0 += weights_peephole(0, j) * c_states_tm1_l(i, j);
+                G1 += weights_peephole(1, j) * c_states_tm1_l(i, j);
+            }
+            ws_gates(i, 0, j) = logistic_fwd(G0);
+            ws_gates(i, 1, j) = logistic_fwd(G1);
             ws_gates(i, 2, j) = tanh_fwd(ws_gates(i, 2, j) + bias(2, j));
-            ws_gates(i, 3, j) = logistic_fwd(ws_gates(i, 3, j) + bias(3, j));
 
             float tmp = ws_gates(i, 1, j) * c_states_tm1_l(i, j)
                     + ws_gates(i, 0, j) * ws_gates(i, 2, j);
+
+            // the output gate of a peephole LSTM looks at the new cell state
+            float G3 = ws_gates(i, 3, j) + bias(3, j);
+            if (rnn.is_lstm_peephole)
+                G3 += weights_peephole(2, j) * tmp;
+            ws_gates(i, 3, j) = logistic_fwd(G3);
+
             states_t_l(i, j) = ws_gates(i, 3, j) * tanh_fwd(tmp);
             c_states_t_l(i, j) = tmp;
         }
@@ -60,6 +73,7 @@ template <>
 rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::lstm_postgemm) {
     ws_gates_aoc_s32_t ws_gates_s32(rnn, ws_gates_);
     bias_aoc_t bias(rnn, bias_);
+    weights_peephole_aoc_t weights_peephole(rnn, weights_peephole_);
     ws_states_aoc_u8_t states_t_l(rnn, states_t_l_);
     ws_states_aoc_t c_states_t_l(rnn, c_states_t_l_);
     ws_states_aoc_t c_states_tm1_l(rnn, c_states_tm1_l_);
@@ -83,15 +97,21 @@ rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::lstm_postgemm) {
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
-            float G0 = logistic_fwd<float>(
-                    deq_w(ws_gates_s32(i, 0, j), 0, j) + bias(0, j));
-            float G1 = logistic_fwd<float>(
-                    deq_w(ws_gates_s32(i, 1, j), 1, j) + bias(1, j));
+            float G0 = deq_w(ws_gates_s32(i, 0, j), 0, j) + bias(0, j);
+            float G1 = deq_w(ws_gates_s32(i, 1, j), 1, j) + bias(1, j);
+            if (rnn.is_lstm_peephole) {
+                G0 += weights_peephole(0, j) * c_states_tm1_l(i, j);
+                G1 += weights_peephole(1, j) * c_states_tm1_l(i, j);
+            }
+            G0 = logistic_fwd<float>(G0);
+            G1 = logistic_fwd<float>(G1);
             float G2 = tanh_fwd<float>(
                     deq_w(ws_gates_s32(i, 2, j), 2, j) + bias(2, j));
-            float G3 = logistic_fwd<float>(
-                    deq_w(ws_gates_s32(i, 3, j), 3, j) + bias(3, j));
             float tmp = G1 * c_states_tm1_l(i, j) + G0 * G2;
+            float G3 = deq_w(ws_gates_s32(i, 3, j), 3, j) + bias(3, j);
+            if (rnn.is_lstm_peephole)
+                G3 += weights_peephole(2, j) * tmp;
+            G3 = logistic_fwd<float>(G3);
             states_t_l(i, j) = q_d(G3 * tanh_fwd(tmp));
             c_states_t_l(i, j) = tmp;
         }
@@ -29,10 +29,14 @@
 
  */
 
+#include <algorithm>
+
+#include "float16.hpp"
 #include "math_utils.hpp"
 #include "mkldnn_thread.hpp"
 
 #include "ref_rnn.hpp"
+#include "../cpu_barrier.hpp"
 #include "../gemm/gemm.hpp"
 #include "../simple_q10n.hpp"
 
@@ -113,19 +117,12 @@ rnn_gemm_sig((ref_rnn_fwd_u8s8_t::packed_gemm)) {
             CblasNoTrans, CblasFixOffset, m, n, k, alpha, a_, ldA, offseta, b_,
             ldB, offsetb, beta, c_, ldC, &offsetc);
 #else
-    UNUSED(transA);
-    UNUSED(transB);
-    UNUSED(m);
-    UNUSED(n);
-    UNUSED(k);
-    UNUSED(alpha);
+    /* The weights of a part are stored as a plain m x k matrix */
     UNUSED(ldA);
-    UNUSED(b_);
-    UNUSED(ldB);
-    UNUSED(beta);
-    UNUSED(c_);
-    UNUSED(ldC);
-    assert(!"packed gemm is disabled");
+    int8_t offseta = 0, offsetb = 0;
+    int32_t offsetc = 0;
+    gemm_s8x8s32<uint8_t>(&transA, &transB, "F", &m, &n, &k, &alpha, a_, &m,
+            &offseta, b_, &ldB, &offsetb, &beta, c_, &ldC, &offsetc);
 #endif
 }
 
@@ -157,6 +154,29 @@ rnn_grid_execution_sig(
             diff_bias_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dic);
     AOC<float, 4> ws_grid(
             ws_grid_, rnn.n_layer, rnn.n_dir, rnn.n_iter, (int)rnn.ws_per_cell);
+    AOC<const float, 3> weights_peephole(
+            weights_peephole_, rnn.n_layer, rnn.n_dir, 3 * rnn.dic);
+    AOC<const weights_data_t, 3> weights_projection(weights_projection_,
+            rnn.n_layer, rnn.n_dir,
+            rnn.weights_projection_nld * rnn.weights_projection_ld);
+
+    /* Backward either has the gates of all the iterations in the workspace,
+     * or recomputes them for segments of ws_checkpoint iterations, starting
+     * from the last one. The c states of a segment start from its checkpoint
+     * and go to their own buffer, followed by the hidden state the
+     * recomputation writes, as the stored one is kept (see set_conf) */
+    const bool recompute = aprop == prop_kind::backward && rnn.ws_checkpoint;
+    const int seg_len = recompute ? rnn.ws_checkpoint : rnn.n_iter;
+    const int n_seg = div_up(rnn.n_iter, seg_len);
+    const bool is_lstm = pd()->cell_kind() == alg_kind::vanilla_lstm;
+    const size_t state_size = (size_t)rnn.states_nld * rnn.states_ws_ld;
+    const size_t gates_size = (size_t)rnn.gates_nld * rnn.gates_ws_ld;
+    const size_t n_ckpt_states = recompute && is_lstm
+            ? (size_t)rnn.n_layer * rnn.n_dir * n_seg
+            : 0;
+    float *ws_seg_c_states = ws_c_states_ + n_ckpt_states * state_size;
+    src_data_t *ws_recompute_h = reinterpret_cast<src_data_t *>(
+            ws_seg_c_states + (n_ckpt_states ? seg_len : 0) * state_size);
 
     // We run the grid of computation
     for (int dir = 0; dir < rnn.n_dir; dir++) {
@@ -171,56 +191,321 @@ rnn_grid_execution_sig(
                         &(ws_gates(lay, dir, 0, 0)), rnn.gates_ws_ld);
             }
 
-            for (int i = 0; i < rnn.n_iter; i++) {
-                int iter = (aprop == prop_kind::forward) ? i : rnn.n_iter - i - 1;
-                (this->*cell_func)(rnn,
-                        &(ws_states(lay + 1, dir, iter + 1, 0)),
-                        &(ws_c_states(lay + 1, dir, iter + 1, 0)),
-                        &(ws_diff_states(lay, dir, 0, iter, 0)),
-                        &(weights_input(lay, dir, 0)),
-                        &(weights_states(lay, dir, 0)),
-                        &(bias(lay, dir, 0)),
-                        &(ws_states(lay, dir, iter + 1, 0)),
-                        &(ws_states(lay + 1, dir, iter, 0)),
-                        &(ws_c_states(lay + 1, dir, iter, 0)),
-                        &(ws_diff_states(lay + 1, dir, 0, iter, 0)),
-                        &(ws_diff_states(lay, dir, 0, iter + 1, 0)),
-                        &(diff_weights_layer(lay, dir, 0)),
-                        &(diff_weights_iter(lay, dir, 0)),
-                        &(diff_bias(lay, dir, 0)),
-                        &(ws_gates(lay, dir, iter, 0)),
-                        &(ws_grid(lay, dir, iter, 0)),
-                        ws_cell_);
-            }
+            for (int s = 0; s < n_seg; s++) {
+                int seg = (aprop == prop_kind::forward) ? s : n_seg - s - 1;
+                const int iter_start = seg * seg_len;
+                const int iter_end = nstl::min(iter_start + seg_len, rnn.n_iter);
+
+                float *c_states_start = ws_c_states_
+                        + ((size_t)(lay * rnn.n_dir + dir) * n_seg + seg)
+                                * state_size;
+                if (recompute)
+                    recompute_gates(rnn, iter_end - iter_start,
+                            &(weights_input(lay, dir, 0)),
+                            &(weights_states(lay, dir, 0)),
+                            &(bias(lay, dir, 0)),
+                            &(ws_states(lay, dir, iter_start + 1, 0)),
+                            &(ws_states(lay + 1, dir, iter_start, 0)),
+                            ws_recompute_h, c_states_start, ws_seg_c_states,
+                            ws_gates_, ws_grid_, ws_cell_);
+
+                /* c state after iter iterations, gates and grid of iteration
+                 * iter */
+                auto c_states = [&](int iter) {
+                    return !recompute
+                            ? &(ws_c_states(lay + 1, dir, iter, 0))
+                            : iter == iter_start
+                                    ? c_states_start
+                                    : ws_seg_c_states
+                                            + (iter - iter_start - 1)
+                                                    * state_size;
+                };
+                auto gates = [&](int iter) {
+                    return recompute
+                            ? ws_gates_ + (iter - iter_start) * gates_size
+                            : &(ws_gates(lay, dir, iter, 0));
+                };
+                auto grid = [&](int iter) {
+                    return recompute
+                            ? ws_grid_ + (iter - iter_start) * rnn.ws_per_cell
+                            : &(ws_grid(lay, dir, iter, 0));
+                };
+
+                for (int i = iter_start; i < iter_end; i++) {
+                    int iter = (aprop == prop_kind::forward)
+                            ? i
+                            : iter_start + iter_end - i - 1;
+
+                    /* Only the sequences that have not ended yet are
+                     * computed, they are the first seq_mb[t] rows */
+                    const rnn_conf_t *cell_rnn = &rnn;
+                    rnn_conf_t seq_rnn;
+                    if (seq_mb_) {
+                        const bool is_r2l = dir == 1 || rnn.exec_dir == r2l;
+                        const int t = is_r2l ? rnn.n_iter - 1 - iter : iter;
+                        if (seq_mb_[t] == 0)
+                            continue;
+                        seq_rnn = rnn;
+                        seq_rnn.mb = seq_mb_[t];
+                        cell_rnn = &seq_rnn;
+                    }
+
+                    (this->*cell_func)(*cell_rnn,
+                            &(ws_states(lay + 1, dir, iter + 1, 0)),
+                            c_states(iter + 1),
+                            &(ws_diff_states(lay, dir, 0, iter, 0)),
+                            &(weights_input(lay, dir, 0)),
+                            &(weights_states(lay, dir, 0)),
+                            &(bias(lay, dir, 0)),
+                            rnn.is_lstm_peephole
+                                    ? &(weights_peephole(lay, dir, 0))
+                                    : nullptr,
+                            rnn.is_lstm_projection
+                                    ? &(weights_projection(lay, dir, 0))
+                                    : nullptr,
+                            &(ws_states(lay, dir, iter + 1, 0)),
+                            &(ws_states(lay + 1, dir, iter, 0)),
+                            c_states(iter),
+                            &(ws_diff_states(lay + 1, dir, 0, iter, 0)),
+                            &(ws_diff_states(lay, dir, 0, iter + 1, 0)),
+                            &(diff_weights_layer(lay, dir, 0)),
+                            &(diff_weights_iter(lay, dir, 0)),
+                            &(diff_bias(lay, dir, 0)),
+                            gates(iter), grid(iter), ws_cell_);
+                }
 
-            if ((aprop == prop_kind::backward) && rnn.merge_gemm_layer) {
-                (this->*gemm_layer_func)('N', 'N', rnn.slc, rnn.mb * rnn.n_iter,
-                        rnn.n_gates * rnn.dic, 1.0, weights_input(lay, dir, 0),
-                        rnn.weights_layer_ld,
-                        (src_data_t *)(&(ws_gates(lay, dir, 0, 0))),
-                        rnn.gates_ws_ld, 0.0,
-                        (acc_data_t *)(&(ws_diff_states(
-                                lay, dir, rnn.n_states, 0, 0))),
-                        rnn.states_ws_ld);
-                gemm('N', 'T', rnn.n_gates * rnn.dic, rnn.slc,
-                        rnn.mb * rnn.n_iter, 1.0,
-                        (weights_data_t *)(&(ws_gates(lay, dir, 0, 0))),
-                        rnn.gates_ws_ld,
-                        (src_data_t *)(&(ws_states(lay, dir, 1, 0))),
-                        rnn.states_ws_ld, 1.0,
-                        (acc_data_t *)(&(diff_weights_layer(lay, dir, 0))),
-                        rnn.diff_weights_layer_ld);
+                const int n_seg_iter = iter_end - iter_start;
+                if ((aprop == prop_kind::backward) && rnn.merge_gemm_layer) {
+                    (this->*gemm_layer_func)('N', 'N', rnn.slc,
+                            rnn.mb * n_seg_iter, rnn.n_gates * rnn.dic, 1.0,
+                            weights_input(lay, dir, 0), rnn.weights_layer_ld,
+                            (src_data_t *)gates(iter_start), rnn.gates_ws_ld,
+                            0.0,
+                            (acc_data_t *)(&(ws_diff_states(
+                                    lay, dir, rnn.n_states, iter_start, 0))),
+                            rnn.states_ws_ld);
+                    gemm('N', 'T', rnn.n_gates * rnn.dic, rnn.slc,
+                            rnn.mb * n_seg_iter, 1.0,
+                            (weights_data_t *)gates(iter_start),
+                            rnn.gates_ws_ld,
+                            (src_data_t *)(&(ws_states(
+                                    lay, dir, iter_start + 1, 0))),
+                            rnn.states_ws_ld, 1.0,
+                            (acc_data_t *)(&(diff_weights_layer(lay, dir, 0))),
+                            rnn.diff_weights_layer_ld);
+                }
+                if ((aprop == prop_kind::backward) && rnn.merge_gemm_iter) {
+                    gemm('N', 'T', rnn.n_gates * rnn.dic, rnn.sic,
+                            rnn.mb * n_seg_iter, 1.0,
+                            (weights_data_t *)gates(iter_start),
+                            rnn.gates_ws_ld,
+                            (src_data_t *)(&(ws_states(
+                                    lay + 1, dir, iter_start, 0))),
+                            rnn.states_ws_ld, 1.0,
+                            (acc_data_t *)(&(diff_weights_iter(lay, dir, 0))),
+                            rnn.diff_weights_iter_ld);
+                }
             }
-            if ((aprop == prop_kind::backward) && rnn.merge_gemm_iter) {
-                gemm('N', 'T', rnn.n_gates * rnn.dic, rnn.sic,
-                        rnn.mb * rnn.n_iter, 1.0,
-                        (weights_data_t *)(&(ws_gates(lay, dir, 0, 0))),
-                        rnn.gates_ws_ld,
-                        (src_data_t *)(&(ws_states(lay + 1, dir, 0, 0))),
-                        rnn.states_ws_ld, 1.0,
-                        (acc_data_t *)(&(diff_weights_iter(lay, dir, 0))),
-                        rnn.diff_weights_iter_ld);
+        }
+    }
+}
+
+/* Runs the forward cells of n_iter iterations of a layer again to get back the gates backward needs. The backward weights
+ * are transposed (ldgoi), so the gemms use them as such. The hidden states
+ * are already there, the one computed goes to a buffer of its own. */
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
+void _ref_rnn_common_t<aprop, src_type, weights_type>::recompute_gates(
+        const rnn_conf_t &rnn, int n_iter, weights_data_t **w_layer_, weights_data_t **w_iter_, float **bias_,
+        src_data_t *ws_states_t_lm1_, src_data_t *ws_states_tm1_l_,
+        src_data_t *states_t_l_, float *c_states_start_, float *ws_c_states_,
+        acc_data_t *ws_gates_, float *ws_grid_, acc_data_t *ws_cell_) const {
+    assert(aprop == prop_kind::backward && rnn_fwd_postgemm_ != nullptr);
+    const size_t state_size = (size_t)rnn.states_nld * rnn.states_ws_ld;
+    const size_t gates_size = (size_t)rnn.gates_nld * rnn.gates_ws_ld;
+    const bool is_gru = pd()->cell_kind() == alg_kind::vanilla_gru;
+
+    gemm('T', 'N', rnn.n_gates * rnn.dic, rnn.mb * n_iter, rnn.slc, 1.0,
+            w_layer_[0], rnn.weights_layer_ld, ws_states_t_lm1_,
+            rnn.states_ws_ld, 0.0, ws_gates_, rnn.gates_ws_ld);
+
+    for (int i = 0; i < n_iter; i++) {
+        acc_data_t *gates = ws_gates_ + i * gates_size;
+        src_data_t *states_tm1_l = ws_states_tm1_l_ + i * state_size;
+        float *c_states_tm1_l = i == 0
+                ? c_states_start_
+                : ws_c_states_ + (i - 1) * state_size;
+        float *c_states_t_l = ws_c_states_ + i * state_size;
+        float *grid = ws_grid_ + i * rnn.ws_per_cell;
+
+        if (rnn.is_lbr)
+            gemm('T', 'N', rnn.n_gates * rnn.dic, rnn.mb, rnn.sic, 1.0,
+                    w_iter_[0], rnn.weights_iter_ld, states_tm1_l,
+                    rnn.states_ws_ld, 0.0, ws_cell_, rnn.gates_ws_ld);
+        else
+            gemm('T', 'N', (is_gru ? rnn.n_gates - 1 : rnn.n_gates) * rnn.dic,
+                    rnn.mb,
+                    rnn.sic, 1.0, w_iter_[0], rnn.weights_iter_ld,
+                    states_tm1_l, rnn.states_ws_ld, 1.0, gates,
+                    rnn.gates_ws_ld);
+
+        rnn_fwd_postgemm_->execute(rnn, gates, states_t_l_, c_states_t_l,
+                states_tm1_l, c_states_tm1_l, nullptr, nullptr, nullptr,
+                bias_[0], nullptr, grid, ws_cell_);
+
+        if (is_gru) {
+            gemm('T', 'N', rnn.dic, rnn.mb, rnn.sic, 1.0, w_iter_[1],
+                    rnn.weights_iter_ld, states_t_l_, rnn.states_ws_ld, 1.0,
+                    gates + 2 * rnn.dic, rnn.gates_ws_ld);
+            rnn_fwd_postgemm_->execute_part2(rnn, gates, states_t_l_,
+                    c_states_t_l, states_tm1_l, c_states_tm1_l, nullptr,
+                    nullptr, nullptr, bias_[0], nullptr, grid, ws_cell_);
+        }
+    }
+}
+
+//************** Grid computations strategy: wavefront **************//
+/* Cell (lay, iter) only depends on cells (lay - 1, iter) and (lay, iter - 1),
+ * so all the cells on an anti-diagonal lay + iter = const are independent.
+ * They are run concurrently, each one on its own share of the threads, which
+ * split the minibatch between them. The two directions of a bidirectional
+ * RNN are independent as well and run side by side on separate threads.
+ * Forward inference only. */
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
+rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type,
+        weights_type>::wavefront_execution)) {
+    assert(aprop == prop_kind::forward && !rnn.merge_gemm_layer);
+    AOC<src_data_t, 4> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
+            rnn.n_iter + 1, rnn.states_nld * rnn.states_ws_ld);
+    AOC<float, 4> ws_c_states(ws_c_states_, rnn.n_layer + 1, rnn.n_dir,
+            rnn.n_iter + 1, rnn.states_nld * rnn.states_ws_ld);
+    AOC<acc_data_t, 4> ws_gates(ws_gates_, rnn.n_layer, rnn.n_dir, rnn.n_iter,
+            rnn.gates_nld * rnn.gates_ws_ld);
+    AOC<weights_data_t *, 3> weights_input(
+            weights_layer_, rnn.n_layer, rnn.n_dir, rnn.n_parts_weights_layer);
+    AOC<weights_data_t *, 3> weights_states(
+            weights_states_, rnn.n_layer, rnn.n_dir, rnn.n_parts_weights_iter);
+    AOC<float*, 3> bias(
+        bias_, rnn.n_layer, rnn.n_dir, rnn.n_parts_bias);
+    AOC<const float, 3> weights_peephole(
+            weights_peephole_, rnn.n_layer, rnn.n_dir, 3 * rnn.dic);
+    AOC<const weights_data_t, 3> weights_projection(weights_projection_,
+            rnn.n_layer, rnn.n_dir,
+            rnn.weights_projection_nld * rnn.weights_projection_ld);
+    /* ws_cell_ holds one buffer per layer and direction (see set_conf) */
+    const size_t ws_cell_per_layer = rnn.ws_cell_comp_size / sizeof(acc_data_t)
+            / (rnn.n_layer * rnn.n_dir);
+
+    const int nthr = mkldnn_get_max_threads();
+    const int n_diag = rnn.n_layer + rnn.n_iter - 1;
+
+    for (int diag = 0; diag < n_diag; diag++) {
+        const int lay_start = nstl::max(0, diag - rnn.n_iter + 1);
+        const int lay_end = nstl::min(rnn.n_layer, diag + 1);
+        const int n_cells = lay_end - lay_start;
+        const int n_chunks = nstl::min(rnn.mb,
+                nstl::max(1, nthr / (rnn.n_dir * n_cells)));
+
+        parallel_nd(rnn.n_dir, n_cells, n_chunks,
+                [&](int dir, int c, int chunk) {
+            const int lay = lay_start + c;
+            const int iter = diag - lay;
+            int mb_start{0}, mb_end{0};
+            balance211(rnn.mb, n_chunks, chunk, mb_start, mb_end);
+
+            rnn_conf_t rnn_chunk = rnn;
+            rnn_chunk.mb = mb_end - mb_start;
+            const int s_off = mb_start * rnn.states_ws_ld;
+            const int g_off = mb_start * rnn.gates_ws_ld;
+            /* the projection keeps the hidden state there, otherwise it
+             * holds gates */
+            const int c_off = rnn.is_lstm_projection ? s_off : g_off;
+
+            (this->*cell_func)(rnn_chunk,
+                    &(ws_states(lay + 1, dir, iter + 1, s_off)),
+                    &(ws_c_states(lay + 1, dir, iter + 1, s_off)),
+                    ws_diff_states_,
+                    &(weights_input(lay, dir, 0)),
+                    &(weights_states(lay, dir, 0)),
+                    &(bias(lay, dir, 0)),
+                    rnn.is_lstm_peephole
+                            ? &(weights_peephole(lay, dir, 0)) : nullptr,
+                    rnn.is_lstm_projection
+                            ? &(weights_projection(lay, dir, 0)) : nullptr,
+                    &(ws_states(lay, dir, iter + 1, s_off)),
+                    &(ws_states(lay + 1, dir, iter, s_off)),
+                    &(ws_c_states(lay + 1, dir, iter, s_off)),
+                    ws_diff_states_, ws_diff_states_,
+                    diff_weights_layer_, diff_weights_iter_, diff_bias_,
+                    &(ws_gates(lay, dir, iter, g_off)),
+                    ws_grid_,
+                    ws_cell_ + (dir * rnn.n_layer + lay) * ws_cell_per_layer
+                            + c_off);
+        });
+    }
+}
+
+//************** Grid computations strategy: persistent **************//
+/* A single parallel region runs all the iterations of a layer. Every thread
+ * owns the same blocks of dic, i.e. the same rows of the weights, at every
+ * iteration, so its slice of the weights stays in its cache for the whole
+ * sequence. Threads only synchronize once per iteration, as the next one
+ * needs the whole hidden state. Forward inference of LSTM only. */
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
+rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type,
+        weights_type>::persistent_execution)) {
+    assert(aprop == prop_kind::forward && rnn.use_fused_cell);
+    AOC<src_data_t, 4> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
+            rnn.n_iter + 1, rnn.states_nld * rnn.states_ws_ld);
+    AOC<float, 4> ws_c_states(ws_c_states_, rnn.n_layer + 1, rnn.n_dir,
+            rnn.n_iter + 1, rnn.states_nld * rnn.states_ws_ld);
+    AOC<acc_data_t, 4> ws_gates(ws_gates_, rnn.n_layer, rnn.n_dir, rnn.n_iter,
+            rnn.gates_nld * rnn.gates_ws_ld);
+    AOC<weights_data_t *, 3> weights_input(
+            weights_layer_, rnn.n_layer, rnn.n_dir, rnn.n_parts_weights_layer);
+    AOC<weights_data_t *, 3> weights_states(
+            weights_states_, rnn.n_layer, rnn.n_dir, rnn.n_parts_weights_iter);
+    AOC<float*, 3> bias(
+        bias_, rnn.n_layer, rnn.n_dir, rnn.n_parts_bias);
+
+    const int nb_dic = div_up(rnn.dic, rnn.fused_dic_block);
+
+    for (int dir = 0; dir < rnn.n_dir; dir++) {
+        for (int lay = 0; lay < rnn.n_layer; lay++) {
+            if (rnn.merge_gemm_layer) {
+                (this->*gemm_layer_func)('N', 'N', rnn.n_gates * rnn.dic,
+                        rnn.mb * rnn.n_iter, rnn.slc, 1.0,
+                        weights_input(lay, dir, 0), rnn.weights_layer_ld,
+                        &(ws_states(lay, dir, 1, 0)), rnn.states_ws_ld, 0.0,
+                        &(ws_gates(lay, dir, 0, 0)), rnn.gates_ws_ld);
             }
+
+            simple_barrier::ctx_t barrier;
+            simple_barrier::ctx_init(&barrier);
+
+            parallel(0, [&](const int ithr, const int nthr) {
+                int jb_start{0}, jb_end{0};
+                balance211(nb_dic, nthr, ithr, jb_start, jb_end);
+
+                for (int iter = 0; iter < rnn.n_iter; iter++) {
+                    for (int jb = jb_start; jb < jb_end; jb++) {
+                        const int j_start = jb * rnn.fused_dic_block;
+                        const int j_size = nstl::min(
+                                rnn.fused_dic_block, rnn.dic - j_start);
+                        lstm_fused_block(rnn, j_start, j_size,
+                                &(ws_states(lay + 1, dir, iter + 1, 0)),
+                                &(ws_c_states(lay + 1, dir, iter + 1, 0)),
+                                &(weights_input(lay, dir, 0)),
+                                &(weights_states(lay, dir, 0)),
+                                &(bias(lay, dir, 0)),
+                                &(ws_states(lay, dir, iter + 1, 0)),
+                                &(ws_states(lay + 1, dir, iter, 0)),
+                                &(ws_c_states(lay + 1, dir, iter, 0)),
+                                &(ws_gates(lay, dir, iter, 0)));
+                    }
+                    if (nthr > 1)
+                        simple_barrier::barrier(&barrier, nthr);
+                }
+            });
         }
     }
 }
@@ -231,14 +516,15 @@ template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
 void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_init_layer(
         const rnn_conf_t &rnn, src_data_t *__restrict ws_states_,
         float *__restrict ws_diff_states_, const src_data_t *__restrict xt_,
-        const float *__restrict diff_dst_layer_) const {
+        const float *__restrict diff_dst_layer_,
+        const int *__restrict seq_perm_) const {
 
     AOC<src_data_t, 4> ws_states(
             ws_states_, rnn.n_dir, rnn.n_iter + 1, rnn.mb, rnn.states_ws_ld);
     auto xt_d = memory_desc_wrapper(pd()->src_md(0));
 
     parallel_nd(rnn.n_iter, rnn.mb, [&](int it, int b) {
-        auto xxt = xt_ + xt_d.blk_off(it, b);
+        auto xxt = xt_ + xt_d.blk_off(it, seq_perm_ ? seq_perm_[b] : b);
         src_data_t *ws_l2r_ptr = &(ws_states(0, it + 1, b, 0));
         src_data_t *ws_r2l_ptr = &(ws_states(rnn.n_dir - 1, rnn.n_iter - it, b, 0));
         if (rnn.exec_dir != r2l)
@@ -253,7 +539,7 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_init_layer(
 template <>
 void ref_rnn_bwd_f32_t::copy_init_layer(const rnn_conf_t &rnn,
         src_data_t *ws_states_, float *ws_diff_states_, const src_data_t *xt_,
-        const float *diff_dst_layer_) const {
+        const float *diff_dst_layer_, const int *seq_perm_) const {
     AOC<float, 6> ws_diff_states(ws_diff_states_, rnn.n_layer + 1, rnn.n_dir,
             (rnn.n_states + 1), rnn.n_iter + 1, rnn.mb, rnn.states_ws_ld);
     auto diff_dst_layer_d = memory_desc_wrapper(pd()->diff_dst_md(0));
@@ -320,7 +606,8 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_init_iter(
         const rnn_conf_t &rnn, src_data_t *__restrict ws_states_,
         float *__restrict ws_c_states_, float *__restrict ws_diff_states_,
         const input_data_t *__restrict firstit_states_,
-        const float *__restrict diff_dst_iter_) const {
+        const float *__restrict diff_dst_iter_,
+        const int *__restrict seq_perm_, const int *__restrict seq_len_) const {
     AOC<src_data_t, 5> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
             rnn.n_iter + 1, rnn.mb, rnn.states_ws_ld);
     AOC<float, 5> ws_c_states(ws_c_states_, rnn.n_layer + 1, rnn.n_dir,
@@ -351,15 +638,16 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_init_iter(
     if (firstit_states_) {
         parallel_nd(
                 rnn.n_layer, rnn.n_dir, rnn.mb, [&](int lay, int dir, int b) {
+                    const int b_src = seq_perm_ ? seq_perm_[b] : b;
                     for (int s = 0; s < rnn.sic; s++)
                         ws_states(lay + 1, dir, 0, b, s) = maybe_q(
                                 firstit_states_[firstit_states_d.blk_off(
-                                        lay, dir, 0, b, s)]);
+                                        lay, dir, 0, b_src, s)]);
                     if (pd()->cell_kind() == alg_kind::vanilla_lstm)
                         for (int s = 0; s < rnn.sic; s++)
                             ws_c_states(lay + 1, dir, 0, b, s) = maybe_deq(
                                     firstit_states_[firstit_states_d.blk_off(
-                                            lay, dir, 1, b, s)]);
+                                            lay, dir, 1, b_src, s)]);
                 });
     } else {
         parallel_nd(
@@ -370,14 +658,31 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_init_iter(
                     }
         });
     }
+
+    /* The right to left direction of a shorter sequence starts at its end,
+     * so it needs the first states at the iteration before that */
+    if (seq_len_ && rnn.exec_dir != l2r) {
+        const int dir = rnn.n_dir - 1;
+        parallel_nd(rnn.n_layer, rnn.mb, [&](int lay, int b) {
+            const int it = rnn.n_iter - seq_len_[b];
+            if (it == 0)
+                return;
+            for (int s = 0; s < rnn.sic; s++) {
+                ws_states(lay + 1, dir, it, b, s)
+                        = ws_states(lay + 1, dir, 0, b, s);
+                ws_c_states(lay + 1, dir, it, b, s)
+                        = ws_c_states(lay + 1, dir, 0, b, s);
+            }
+        });
+    }
 }
 
 template <>
 template <typename input_data_t>
 void ref_rnn_bwd_f32_t::copy_init_iter(const rnn_conf_t &rnn,
         src_data_t *ws_states_, float *ws_c_states_, float *ws_diff_states_,
-        const input_data_t *firstit_states_,
-        const float *diff_dst_iter_) const {
+        const input_data_t *firstit_states_, const float *diff_dst_iter_,
+        const int *seq_perm_, const int *seq_len_) const {
     AOC<float, 6> ws_diff_states(ws_diff_states_, rnn.n_layer + 1, rnn.n_dir,
             rnn.n_states + 1, rnn.n_iter + 1, rnn.mb, rnn.states_ws_ld);
     auto diff_dst_iter_d = memory_desc_wrapper(pd()->diff_dst_md(1));
@@ -405,7 +710,8 @@ template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
 template <typename dst_data_t>
 void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_res_layer(
         const rnn_conf_t &rnn, dst_data_t *dst_layer_, float *diff_src_layer,
-        const src_data_t *ws_states_, const float *ws_diff_states_) const {
+        const src_data_t *ws_states_, const float *ws_diff_states_,
+        const int *seq_perm_, const int *seq_len_) const {
 
     auto dst_layer_d = memory_desc_wrapper(pd()->dst_md(0));
     AOC<const src_data_t, 5> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
@@ -421,12 +727,21 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_res_layer(
         else
             return (dst_data_t)s;
     };
+    // past the end of a sequence the output is zero
+    const src_data_t ws_zero = rnn.dt_conf == all_f32
+            ? (src_data_t)0 : qz_a1b0<float, src_data_t>()(shift);
     parallel_nd(rnn.n_iter, rnn.mb, [&](int it, int b) {
+        const bool is_padding = seq_len_ && it >= seq_len_[b];
+        auto ws = [&](int dir, int iter, int s) {
+            return is_padding ? ws_zero
+                              : ws_states(rnn.n_layer, dir, iter, b, s);
+        };
+        const int b_dst = seq_perm_ ? seq_perm_[b] : b;
         int dir = 0;
         if (rnn.exec_dir != r2l) {
             for (int s = 0; s < rnn.dic; s++) {
-                dst_layer_[dst_layer_d.blk_off(it, b, dir * rnn.dic + s)]
-                        = maybe_deq(ws_states(rnn.n_layer, dir, it + 1, b, s));
+                dst_layer_[dst_layer_d.blk_off(it, b_dst, dir * rnn.dic + s)]
+                        = maybe_deq(ws(dir, it + 1, s));
             }
             dir = 1;
         }
@@ -434,14 +749,13 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_res_layer(
             for (int s = 0; s < rnn.dic; s++)
                 switch (rnn.exec_dir) {
                 case bi_sum:
-                    dst_layer_[dst_layer_d.blk_off(it, b, s)]
-                            += maybe_deq(ws_states(
-                                    rnn.n_layer, dir, rnn.n_iter - it, b, s));
+                    dst_layer_[dst_layer_d.blk_off(it, b_dst, s)]
+                            += maybe_deq(ws(dir, rnn.n_iter - it, s));
                     break;
                 default:
-                    dst_layer_[dst_layer_d.blk_off(it, b, dir * rnn.dic + s)]
-                            = maybe_deq(ws_states(
-                                    rnn.n_layer, dir, rnn.n_iter - it, b, s));
+                    dst_layer_[dst_layer_d.blk_off(
+                            it, b_dst, dir * rnn.dic + s)]
+                            = maybe_deq(ws(dir, rnn.n_iter - it, s));
                 }
         }
     });
@@ -451,7 +765,8 @@ template <>
 template <typename dst_data_t>
 void ref_rnn_bwd_f32_t::copy_res_layer(
         const rnn_conf_t &rnn, dst_data_t *dst_layer_, float *diff_src_layer_,
-        const src_data_t *ws_states_, const float *ws_diff_states_) const {
+        const src_data_t *ws_states_, const float *ws_diff_states_,
+        const int *seq_perm_, const int *seq_len_) const {
     auto diff_src_layer_d = memory_desc_wrapper(pd()->diff_src_md(0));
     AOC<const float, 6> ws_diff_states(ws_diff_states_, rnn.n_layer + 1,
             rnn.n_dir, rnn.n_states + 1, rnn.n_iter + 1, rnn.mb,
@@ -478,7 +793,8 @@ template <typename output_data_t>
 void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_res_iter(
         const rnn_conf_t &rnn, output_data_t *dst_iter_, float *diff_src_iter_,
         const src_data_t *ws_states_, float *ws_c_states_,
-        const float *ws_diff_states_) const {
+        const float *ws_diff_states_, const int *seq_perm_,
+        const int *seq_len_) const {
     auto dst_iter_d = memory_desc_wrapper(pd()->dst_md(1));
     AOC<const src_data_t, 5> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
             rnn.n_iter + 1, rnn.mb, rnn.states_ws_ld);
@@ -510,15 +826,19 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_res_iter(
     if (dst_iter_) {
         parallel_nd(rnn.n_layer, rnn.n_dir, rnn.mb,
                 [&](int lay, int dir, int b) {
+            // left to right directions end at the end of each sequence
+            const bool is_r2l = dir == 1 || rnn.exec_dir == r2l;
+            const int it = seq_len_ && !is_r2l ? seq_len_[b] : rnn.n_iter;
+            const int b_dst = seq_perm_ ? seq_perm_[b] : b;
             for (int s = 0; s < rnn.dic; s++) {
-                dst_iter_[dst_iter_d.blk_off(lay, dir, 0, b, s)]
-                        = maybe_deq(ws_states(lay + 1, dir, rnn.n_iter, b, s));
+                dst_iter_[dst_iter_d.blk_off(lay, dir, 0, b_dst, s)]
+                        = maybe_deq(ws_states(lay + 1, dir, it, b, s));
             }
             if (pd()->cell_kind() == alg_kind::vanilla_lstm)
                     for (int s = 0; s < rnn.dic; s++) {
-                        dst_iter_[dst_iter_d.blk_off(lay, dir, 1, b, s)]
+                        dst_iter_[dst_iter_d.blk_off(lay, dir, 1, b_dst, s)]
                                 = maybe_q(ws_c_states(
-                                        lay + 1, dir, rnn.n_iter, b, s));
+                                        lay + 1, dir, it, b, s));
                     }
             });
     }
@@ -529,7 +849,8 @@ template <typename output_data_t>
 void ref_rnn_bwd_f32_t::copy_res_iter(
         const rnn_conf_t &rnn, output_data_t *dst_iter_, float *diff_src_iter_,
         const src_data_t *ws_states_, float *ws_c_states_,
-        const float *ws_diff_states_) const {
+        const float *ws_diff_states_, const int *seq_perm_,
+        const int *seq_len_) const {
     auto diff_src_iter_d = memory_desc_wrapper(pd()->diff_src_md(1));
     AOC<const float, 6> ws_diff_states(ws_diff_states_, rnn.n_layer + 1,
             rnn.n_dir, rnn.n_states + 1, rnn.n_iter + 1, rnn.mb,
@@ -583,13 +904,24 @@ rnn_bias_finalize_sig(
         float data_scale = pd()->attr()->rnn_data_qparams_.scale_;
         float *weights_scales = pd()->attr()->rnn_weights_qparams_.scales_;
         bool scale_per_oc = pd()->attr()->rnn_weights_qparams_.mask_ != 0;
+        /* The compensation has one entry per gate, while GRU with linear
+         * before reset has an extra bias for the candidate gate that only
+         * applies to the iter gemm, so the iter compensation of that gate
+         * goes there */
+        const bool is_lbr
+                = pd()->cell_kind() == alg_kind::gru_linear_before_reset;
         for (int i = 0; i < rnn.n_layer * rnn.n_dir; i++)
-            for (int j = 0; j < rnn.n_bias * rnn.dic; j++) {
-                size_t off = i * rnn.n_bias * rnn.dic + j;
+            for (int j = 0; j < rnn.n_gates * rnn.dic; j++) {
+                size_t off_comp = i * rnn.n_gates * rnn.dic + j;
+                size_t off_layer = i * rnn.n_bias * rnn.dic + j;
+                size_t off_iter = is_lbr && j >= 2 * rnn.dic
+                        ? off_layer + rnn.dic
+                        : off_layer;
                 float weights_scale
                         = scale_per_oc ? weights_scales[j] : weights_scales[0];
-                scratch_bias_[off] -= (w_iter_comp[off] + w_layer_comp[off])
-                        * data_shift / (weights_scale * data_scale);
+                float comp_scale = data_shift / (weights_scale * data_scale);
+                scratch_bias_[off_layer] -= w_layer_comp[off_comp] * comp_scale;
+                scratch_bias_[off_iter] -= w_iter_comp[off_comp] * comp_scale;
             }
     }
 }
@@ -634,6 +966,79 @@ rnn_weights_assign_sig(
         }
 }
 
+namespace {
+template <typename ws_data_t>
+void copy_workspace_part(ws_data_t *ws, float *ws_f32, size_t nelems,
+        bool to_ws) {
+    if (to_ws)
+        for (size_t i = 0; i < nelems; i++)
+            ws[i] = ws_f32[i];
+    else
+        for (size_t i = 0; i < nelems; i++)
+            ws_f32[i] = ws[i];
+}
+}
+
+/* Forward training stores what backward needs to the compact workspace once
+ * the grid is done, and backward loads it back before starting. With
+ * checkpoints, these are the states and the c states of every ws_checkpoint
+ * iteration, which backward puts first in its c states buffer. */
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
+void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_compact_workspace(
+        const rnn_conf_t &rnn, char *ws_compact_, char *ws_f32_,
+        bool to_compact) const {
+    auto copy_part = [&](char *ws, float *ws_f32, size_t nelems) {
+        if (rnn.use_f16_workspace)
+            copy_workspace_part(
+                    (float16_t *)ws, ws_f32, nelems, to_compact);
+        else
+            copy_workspace_part((float *)ws, ws_f32, nelems, to_compact);
+    };
+    const size_t dt_size
+            = rnn.use_f16_workspace ? sizeof(float16_t) : sizeof(float);
+    auto copy = [&](size_t compact_offset, size_t f32_offset, size_t size) {
+        char *ws = ws_compact_ + compact_offset;
+        float *ws_f32 = (float *)(ws_f32_ + f32_offset);
+        const size_t nelems = size / sizeof(float);
+        const size_t block = 1024;
+        parallel_nd(utils::div_up(nelems, block), [&](size_t ib) {
+            const size_t start = ib * block;
+            const size_t end = nstl::min(start + block, nelems);
+            copy_part(ws + start * dt_size, ws_f32 + start, end - start);
+        });
+    };
+
+    copy(ws_compact_states_offset_, ws_states_offset_, rnn.ws_states_size);
+    if (!rnn.ws_checkpoint) {
+        copy(ws_compact_gates_offset_, ws_gates_offset_, rnn.ws_gates_size);
+        copy(ws_compact_c_states_offset_, ws_c_states_offset_,
+                rnn.ws_c_states_size);
+        copy(ws_compact_grid_comp_offset_, ws_grid_comp_offset_,
+                rnn.ws_grid_comp_size);
+        return;
+    }
+
+    if (pd()->cell_kind() != alg_kind::vanilla_lstm)
+        return;
+    const size_t state_size = (size_t)rnn.states_nld * rnn.states_ws_ld;
+    const int n_ckpt = utils::div_up(rnn.n_iter, rnn.ws_checkpoint);
+    if (!to_compact) {
+        copy(ws_compact_c_states_offset_, ws_c_states_offset_,
+                rnn.n_layer * rnn.n_dir * n_ckpt * state_size
+                        * sizeof(float));
+        return;
+    }
+    AOC<float, 4> ws_c_states((float *)(ws_f32_ + ws_c_states_offset_),
+            rnn.n_layer + 1, rnn.n_dir, rnn.n_iter + 1, state_size);
+    parallel_nd(rnn.n_layer, rnn.n_dir, n_ckpt, [&](int lay, int dir, int c) {
+        const size_t ckpt = (size_t)(lay * rnn.n_dir + dir) * n_ckpt + c;
+        copy_part(ws_compact_ + ws_compact_c_states_offset_
+                        + ckpt * state_size * dt_size,
+                &(ws_c_states(lay + 1, dir, c * rnn.ws_checkpoint, 0)),
+                state_size);
+    });
+}
+
 //********************* Execution function *********************//
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
 void _ref_rnn_common_t<aprop, src_type, weights_type>::execute_(
@@ -644,6 +1049,10 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::execute_(
     auto layer_weights_n_comp = CTX_IN_MEM(const char *, MKLDNN_ARG_WEIGHTS_LAYER);
     auto iter_weights_n_comp = CTX_IN_MEM(const char *, MKLDNN_ARG_WEIGHTS_ITER);
     auto bias = CTX_IN_MEM(const float *, MKLDNN_ARG_BIAS);
+    auto weights_peephole
+            = CTX_IN_MEM(const float *, MKLDNN_ARG_WEIGHTS_PEEPHOLE);
+    auto weights_projection
+            = CTX_IN_MEM(const weights_data_t *, MKLDNN_ARG_WEIGHTS_PROJECTION);
 
     auto dst_last_layer = rnn.is_fwd
         ? CTX_OUT_MEM(char *, MKLDNN_ARG_DST_LAYER)
@@ -680,7 +1089,9 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::execute_(
             ? CTX_OUT_MEM(char *, MKLDNN_ARG_WORKSPACE)
             : const_cast<char *>(CTX_IN_MEM(const char *, MKLDNN_ARG_WORKSPACE));
 
-    char *base_ptr = rnn.use_workspace ? ws_ptr : scratch_ptr;
+    char *base_ptr = rnn.use_workspace && !rnn.use_compact_workspace
+            ? ws_ptr
+            : scratch_ptr;
     acc_data_t *ws_gates = (acc_data_t *)(base_ptr + ws_gates_offset_);
     src_data_t *ws_states = (src_data_t *)(base_ptr + ws_states_offset_);
     float *ws_c_states = (float *)(base_ptr + ws_c_states_offset_);
@@ -719,41 +1130,77 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::execute_(
 
     (this->*bias_finalization_func)(rnn, ws_bias, w_iter_comp, w_layer_comp);
 
+    /* Sequences are sorted by decreasing length, so the ones still running
+     * at time t are the first seq_mb[t] rows of the workspace */
+    int *seq_perm = nullptr, *seq_len = nullptr, *seq_mb = nullptr;
+    if (rnn.use_seq_lengths) {
+        auto seq_lengths
+                = CTX_IN_MEM(const int32_t *, MKLDNN_ARG_SRC_SEQ_LENGTHS);
+        auto seq_lengths_d = memory_desc_wrapper(pd()->src_md(2));
+        seq_perm = scratchpad.template get<int>(key_rnn_seq_lengths);
+        seq_len = seq_perm + rnn.mb;
+        seq_mb = seq_len + rnn.mb;
+
+        auto length = [&](int b) {
+            return nstl::max(0, nstl::min(rnn.n_iter,
+                    (int)seq_lengths[seq_lengths_d.off(b)]));
+        };
+        for (int b = 0; b < rnn.mb; b++)
+            seq_perm[b] = b;
+        std::stable_sort(seq_perm, seq_perm + rnn.mb,
+                [&](int a, int b) { return length(a) > length(b); });
+        for (int b = 0; b < rnn.mb; b++)
+            seq_len[b] = length(seq_perm[b]);
+        for (int t = 0, b = rnn.mb; t < rnn.n_iter; t++) {
+            while (b > 0 && seq_len[b - 1] <= t)
+                b--;
+            seq_mb[t] = b;
+        }
+    }
+
     // we first need to copy the initial states and input into ws
-    copy_init_layer(rnn, ws_states, ws_diff_states, input, diff_dst_layer);
+    copy_init_layer(
+            rnn, ws_states, ws_diff_states, input, diff_dst_layer, seq_perm);
     if (rnn.dt_conf == f32u8f32u8 || rnn.dt_conf == f32u8f32f32
             || rnn.dt_conf == all_f32)
         copy_init_iter(rnn, ws_states, ws_c_states, ws_diff_states,
-                (const float *)states, diff_dst_iter);
+                (const float *)states, diff_dst_iter, seq_perm, seq_len);
     else if (rnn.dt_conf == u8u8u8u8 || rnn.dt_conf == u8u8u8f32)
         copy_init_iter(rnn, ws_states, ws_c_states, ws_diff_states,
-                (const uint8_t *)states, diff_dst_iter);
+                (const uint8_t *)states, diff_dst_iter, seq_perm, seq_len);
     else
         assert(!"unimplemented");
 
+    if (rnn.use_compact_workspace && aprop == prop_kind::backward)
+        copy_compact_workspace(rnn, ws_ptr, base_ptr, false);
+
     // run the execution on the grid
     (this->*grid_computation)(rnn, ptr_wei_layer, ptr_wei_iter, ptr_bias,
-            ws_states, ws_c_states, ws_diff_states, ws_gates, ws_cell, ws_grid,
+            weights_peephole, weights_projection, seq_mb, ws_states,
+            ws_c_states, ws_diff_states, ws_gates, ws_cell, ws_grid,
             diff_weights_layer, diff_weights_iter, diff_bias);
 
+    if (rnn.use_compact_workspace && aprop == prop_kind::forward)
+        copy_compact_workspace(rnn, ws_ptr, base_ptr, true);
+
     // Finally we copy the results to the result buffers
     if (rnn.dt_conf == u8u8u8f32 || rnn.dt_conf == f32u8f32f32
             || rnn.dt_conf == all_f32)
         copy_res_layer(rnn, (float *)dst_last_layer, diff_src_layer, ws_states,
-                ws_diff_states);
+                ws_diff_states, seq_perm, seq_len);
     else if (rnn.dt_conf == u8u8u8u8 || rnn.dt_conf == f32u8f32u8)
         copy_res_layer(rnn, (uint8_t *)dst_last_layer, diff_src_layer,
-                ws_states, ws_diff_states);
+                ws_states, ws_diff_states, seq_perm, seq_len);
     else
         assert(!"unimplemented");
 
     if (rnn.dt_conf == f32u8f32u8 || rnn.dt_conf == f32u8f32f32
             || rnn.dt_conf == all_f32)
         copy_res_iter(rnn, (float *)dst_last_iter, diff_src_iter, ws_states,
-                ws_c_states, ws_diff_states);
+                ws_c_states, ws_diff_states, seq_perm, seq_len);
     else if (rnn.dt_conf == u8u8u8u8 || rnn.dt_conf == u8u8u8f32)
         copy_res_iter(rnn, (uint8_t *)dst_last_iter, diff_src_iter, ws_states,
-                ws_c_states, ws_diff_states);
+                ws_c_states, ws_diff_states, seq_perm, seq_len);
     else
         assert(!"unimplemented");
 };
@@ -768,6 +1215,9 @@ template<> rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru);
 template<> rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru_lbr);
 template<> rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution_gru_lbr);
 template<> rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru_lbr);
+template<> rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_fused);
+template<> rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution_fused);
+template<> rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_fused);
 
 template struct _ref_rnn_common_t<prop_kind::forward, data_type::f32, data_type::f32>;
 template struct _ref_rnn_common_t<prop_kind::forward, data_type::u8, data_type::s8>;
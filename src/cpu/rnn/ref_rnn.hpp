@@ -44,7 +44,7 @@ template <prop_kind_t aprop, impl::data_type_t src_type,
 struct _ref_rnn_common_t : public cpu_primitive_t {
     typedef typename prec_traits<src_type>::type src_data_t;
     typedef typename prec_traits<weights_type>::type weights_data_t;
-    typedef typename utils::conditional<src_type == data_type::u8, int32_t,
+    typedef typename utils::conditional<src_type == mkldnn_u8, int32_t,
             float>::type acc_data_t;
 
     using class_name = _ref_rnn_common_t<aprop, src_type, weights_type>;
@@ -102,6 +102,32 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
             if (rnn_.dt_conf == all_f32)
                 ok = ok && this->attr()->has_default_values();
 
+            /* Only the f32 training workspace can be kept in f16 */
+            const data_type_t ws_dt = this->attr()->rnn_workspace_data_type_;
+            if (ws_dt != data_type::f32 && rnn_.dt_conf != all_f32)
+                return status::unimplemented;
+            rnn_.use_f16_workspace
+                    = rnn_.is_training && ws_dt == data_type::f16;
+
+            /* Backward recomputes the gates with the f32 gemm */
+            const int ws_checkpoint
+                    = this->attr()->rnn_workspace_checkpoint_;
+            if (ws_checkpoint != 0 && rnn_.dt_conf != all_f32)
+                return status::unimplemented;
+            rnn_.ws_checkpoint = rnn_.is_training ? ws_checkpoint : 0;
+            rnn_.use_compact_workspace
+                    = rnn_.use_f16_workspace || rnn_.ws_checkpoint != 0;
+
+            /* Peephole and projection are forward only, and the projection
+             * gemm is f32 only */
+            if ((rnn_.is_lstm_peephole || rnn_.is_lstm_projection)
+                    && aprop != prop_kind::forward)
+                return status::unimplemented;
+            if (rnn_.is_lstm_projection && rnn_.dt_conf != all_f32)
+                return status::unimplemented;
+            if (rnn_.use_seq_lengths && aprop != prop_kind::forward)
+                return status::unimplemented;
+
             // Set weights descriptors to desired format
             memory_desc_t new_weights_layer_md = *this->weights_md(0);
             CHECK(set_expected_desc(rnn_, new_weights_layer_md, false));
@@ -139,6 +165,11 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
                         data_type::u8, format_tag::x);
             }
 
+            /* backward reads the workspace as forward training laid it out */
+            if (aprop == prop_kind::backward && this->hint_fwd_pd_
+                    && !this->compare_ws(this->hint_fwd_pd_))
+                return status::unimplemented;
+
             init_scratchpad(scratchpad_sz);
 
             return status::success;
@@ -160,11 +191,18 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
                     sizeof(float *) * ptr_wei_sz);
             scratchpad.book(key_rnn_ptrs_bia,
                     sizeof(float *) * ptr_wei_sz);
+            /* permutation and lengths of the sorted sequences, and the
+             * number of them still running at each iteration */
+            if (rnn_.use_seq_lengths)
+                scratchpad.book(key_rnn_seq_lengths,
+                        sizeof(int) * (2 * rnn_.mb + rnn_.n_iter));
         }
     };
 
     _ref_rnn_common_t(const pd_t *apd)
-        : cpu_primitive_t(apd, true), rnn_postgemm_(nullptr) {
+        : cpu_primitive_t(apd, true)
+        , rnn_postgemm_(nullptr)
+        , rnn_fwd_postgemm_(nullptr) {
         /// @todo set max_feature_size assuming that we limit the number of
         /// iterations and layer to one if slc != dic and sic != dic
         /// respectively
@@ -190,11 +228,18 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
 
         rnn_postgemm_ = new rnn_postgemm_dispatcher<aprop, src_type>(pd()->rnn_, pd());
         assert(rnn_postgemm_ != nullptr);
+        if (aprop == prop_kind::backward && pd()->rnn_.ws_checkpoint)
+            rnn_fwd_postgemm_ = new rnn_postgemm_dispatcher<prop_kind::forward,
+                    src_type>(pd()->rnn_, pd());
         switch (pd()->cell_kind()) {
         case alg_kind::vanilla_rnn:
-        case alg_kind::vanilla_lstm:
             cell_func = &class_name::cell_execution;
             break;
+        case alg_kind::vanilla_lstm:
+            cell_func = pd()->rnn_.use_fused_cell
+                    ? &class_name::cell_execution_fused
+                    : &class_name::cell_execution;
+            break;
         case alg_kind::vanilla_gru:
             cell_func = &class_name::cell_execution_gru;
             break;
@@ -204,17 +249,28 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
         default: break;
         }
 
-        grid_computation = &class_name::linear_execution;
+        if (pd()->rnn_.use_persistent)
+            grid_computation = &class_name::persistent_execution;
+        else if (pd()->rnn_.use_wavefront)
+            grid_computation = &class_name::wavefront_execution;
+        else
+            grid_computation = &class_name::linear_execution;
 
         size_t scratchpad_size, workspace_size;
         rnn_utils::set_offsets(pd()->rnn_, ws_gates_offset_, ws_states_offset_,
                 ws_c_states_offset_, ws_diff_states_offset_,
                 ws_grid_comp_offset_, ws_cell_comp_offset_,
                 ws_bias_offset_, scratchpad_size, workspace_size);
+        if (pd()->rnn_.use_compact_workspace)
+            rnn_utils::set_compact_workspace_offsets(pd()->rnn_,
+                    ws_compact_gates_offset_, ws_compact_states_offset_,
+                    ws_compact_c_states_offset_, ws_compact_grid_comp_offset_,
+                    workspace_size);
     }
 
     ~_ref_rnn_common_t() {
         delete rnn_postgemm_;
+        delete rnn_fwd_postgemm_;
     }
 
     // typedef typename prec_traits::type data_t;
@@ -227,9 +283,12 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
 private:
     void execute_(const exec_ctx_t &ctx) const;
     rnn_grid_execution_sig(linear_execution);
+    rnn_grid_execution_sig(wavefront_execution);
+    rnn_grid_execution_sig(persistent_execution);
     rnn_cell_execution_sig(cell_execution);
     rnn_cell_execution_sig(cell_execution_gru);
     rnn_cell_execution_sig(cell_execution_gru_lbr);
+    rnn_cell_execution_sig(cell_execution_fused);
     rnn_gemm_sig(gemm);
     rnn_gemm_sig(packed_gemm);
     rnn_bias_prepare_sig(bias_prepare);
@@ -241,24 +300,50 @@ private:
 
     void copy_init_layer(const rnn_utils::rnn_conf_t &rnn,
             src_data_t *ws_states_, float *ws_diff_states_,
-            const src_data_t *xt_, const float *diff_dst_layer) const;
+            const src_data_t *xt_, const float *diff_dst_layer,
+            const int *seq_perm_) const;
 
     template <typename input_data_t>
     void copy_init_iter(const rnn_utils::rnn_conf_t &rnn,
             src_data_t *ws_states_, float *ws_c_states, float *ws_diff_states_,
             const input_data_t *firstit_states_,
-            const float *diff_dst_iter) const;
+            const float *diff_dst_iter, const int *seq_perm_,
+            const int *seq_len_) const;
 
     template <typename dst_data_t>
     void copy_res_layer(const rnn_utils::rnn_conf_t &rnn,
             dst_data_t *dst_layer_, float *diff_src_layer,
-            const src_data_t *ws_states_, const float *ws_diff_states_) const;
+            const src_data_t *ws_states_, const float *ws_diff_states_,
+            const int *seq_perm_, const int *seq_len_) const;
 
     template <typename output_data_t>
     void copy_res_iter(const rnn_utils::rnn_conf_t &rnn,
             output_data_t *dst_iter_, float *diff_src_iter,
             const src_data_t *ws_states_, float *ws_c_states,
-            const float *ws_diff_states_) const;
+            const float *ws_diff_states_, const int *seq_perm_,
+            const int *seq_len_) const;
+
+    void lstm_fused_block(const rnn_utils::rnn_conf_t &rnn, int j_start,
+            int j_size, src_data_t *states_t_l_, float *c_states_t_l_,
+            weights_data_t **w_layer_, weights_data_t **w_iter_,
+            float **bias_, src_data_t *states_t_lm1_,
+            src_data_t *states_tm1_l_, float *c_states_tm1_l_,
+            acc_data_t *ws_gates_) const;
+
+    void lstm_projection(const rnn_utils::rnn_conf_t &rnn,
+            src_data_t *states_t_l_, const weights_data_t *w_projection_,
+            const src_data_t *ht_) const;
+
+    void copy_compact_workspace(const rnn_utils::rnn_conf_t &rnn,
+            char *ws_compact_, char *ws_f32_, bool to_compact) const;
+
+    void recompute_gates(const rnn_utils::rnn_conf_t &rnn, int n_iter,
+            weights_data_t **w_layer_, weights_data_t **w_iter_,
+            float **bias_, src_data_t *ws_states_t_lm1_,
+            src_data_t *ws_states_tm1_l_, src_data_t *states_t_l_,
+            float *c_states_start_, float *ws_c_states_,
+            acc_data_t *ws_gates_, float *ws_grid_,
+            acc_data_t *ws_cell_) const;
 
     void gates_reduction(const rnn_utils::rnn_conf_t &rnn,
             const acc_data_t *ws_gates_, float *diff_bias_) const;
@@ -272,7 +357,13 @@ private:
     size_t ws_diff_states_offset_;
     size_t ws_grid_comp_offset_;
     size_t ws_cell_comp_offset_;
+    size_t ws_compact_gates_offset_;
+    size_t ws_compact_states_offset_;
+    size_t ws_compact_c_states_offset_;
+    size_t ws_compact_grid_comp_offset_;
     rnn_postgemm_dispatcher<aprop,src_type> *rnn_postgemm_;
+    /* backward recomputing the gates runs the forward postgemm too */
+    rnn_postgemm_dispatcher<prop_kind::forward, src_type> *rnn_fwd_postgemm_;
 
     grid_execution_f grid_computation;
     cell_execution_f cell_func;
@@ -94,16 +94,12 @@ struct rnn_weights_reorder_t : public cpu_primitive_t {
                 engine_t *engine, const primitive_attr_t *attr,
                 engine_t *src_engine, const memory_desc_t *src_md,
                 engine_t *dst_engine, const memory_desc_t *dst_md) {
-#if !USE_MKL_PACKED_GEMM
-            return status::unimplemented;
-#endif
             const memory_desc_wrapper id(src_md), od(dst_md);
             bool args_ok = true
                     && id.data_type() == type_i
                     && od.data_type() == type_o
                     && od.format_kind() == format_kind::rnn_packed
                     && od.rnn_packed_desc().format == mkldnn_ldigo_p
-                    && od.rnn_packed_desc().n_parts == 1
                     && attr != nullptr;
             if (!args_ok) return status::invalid_arguments;
 
@@ -159,7 +155,6 @@ private:
     rnn_weights_reorder_t(const pd_t *apd): cpu_primitive_t(apd) {}
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-#if USE_MKL_PACKED_GEMM
         auto input = CTX_IN_MEM(const in_data_t *, MKLDNN_ARG_FROM);
         auto output = CTX_OUT_MEM(char *, MKLDNN_ARG_TO);
         const memory_desc_wrapper &input_d = pd()->src_md();
@@ -256,16 +251,26 @@ private:
                     int g = (p > 0) ? parts[p - 1] : 0;
                     int m_p = parts[p] * O;
                     int k_p = I;
+#if USE_MKL_PACKED_GEMM
                     cblas_gemm_s8u8s32_pack(CblasColMajor, CblasAMatrix,
                             is_igo ? CblasNoTrans : CblasTrans, m_p, n, k_p,
                             &quantized[is_igo ? off_igo(l, d, 0, g, 0) :
                                                 off_goi(l, d, g, 0, 0)],
                             is_igo ? G * O : I, to_pack);
+#else
+                    /* Plain column major m_p x k_p matrix */
+                    UNUSED(n);
+                    int8_t *packed = (int8_t *)to_pack;
+                    parallel_nd(k_p, m_p, [&](int i, int go) {
+                        packed[(size_t)i * m_p + go] = is_igo
+                                ? quantized[off_igo(l, d, i, g, 0) + go]
+                                : quantized[off_goi(l, d, i, g, 0) + go * I];
+                    });
+#endif
                     to_pack += size_packed_cell[p];
                 }
             }
         }
-#endif
         return status::success;
     }
 
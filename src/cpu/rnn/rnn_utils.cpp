@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include "c_types_map.hpp"
+#include "float16.hpp"
 #include "math_utils.hpp"
 #include "mkldnn_thread.hpp"
 
@@ -67,6 +68,11 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.is_training = utils::one_of(
             rd.prop_kind, prop_kind::forward_training, prop_kind::backward);
     rnn.is_lbr = rd.cell_desc.cell_kind == mkldnn_gru_linear_before_reset;
+    rnn.is_lstm_peephole = !memory_desc_wrapper(rd.weights_peephole_desc)
+            .is_zero();
+    rnn.is_lstm_projection = !memory_desc_wrapper(rd.weights_projection_desc)
+            .is_zero();
+    rnn.use_seq_lengths = !memory_desc_wrapper(rd.seq_lengths_desc).is_zero();
 
     switch (rd.direction) {
     case mkldnn_unidirectional_left2right: rnn.exec_dir = l2r; break;
@@ -131,6 +137,17 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.merge_gemm_iter = !(rnn.is_fwd || is_gru) || is_int8;
     bool is_inference = !rnn.is_training;
 
+    /* For small batches a single cell gemm cannot keep all the threads busy,
+     * so run all the cells with the same lay + iter, in both directions,
+     * concurrently instead. The layer gemm then has to be computed per cell */
+    bool has_concurrent_cells
+            = (rnn.n_layer > 1 && rnn.n_iter > 1) || rnn.n_dir > 1;
+    rnn.use_wavefront = rnn.is_fwd && is_inference && !is_int8
+            && !rnn.use_seq_lengths && has_concurrent_cells && rnn.mb <= 32 && rnn.dic <= 1024
+            && mkldnn_get_max_threads() > 1;
+    if (rnn.use_wavefront)
+        rnn.merge_gemm_layer = false;
+
     rnn.use_jit_gemm = !mayiuse(avx512_mic)
             && ((is_inference && (rnn.n_layer > 1 || rnn.mb < 100))
                 || (rnn.is_training && rnn.dic < 500));
@@ -150,8 +167,12 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
            && is_inference && rnn.mb >= 16)
         || is_int8;
 #else
-    rnn.use_layer_packed_gemm = false;
-    rnn.use_iter_packed_gemm = false;
+    /* Without MKL the int8 weights are still reordered into the packed
+     * format, which then holds the quantized weights of each part as a plain
+     * column major matrix for the s8u8s32 gemm, followed by the
+     * compensation */
+    rnn.use_layer_packed_gemm = is_int8;
+    rnn.use_iter_packed_gemm = is_int8;
 #endif
 
     /* Set packed gemm sizes */
@@ -175,10 +196,9 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                         = cblas_gemm_s8u8s32_pack_get_size(
                                 CblasAMatrix, m_p, n_p, k_p);
 #else
-            UNUSED(m_p);
-            UNUSED(k_p);
             UNUSED(n_p);
-            rnn.part_weights_layer_pack_size[p] = 0;
+            rnn.part_weights_layer_pack_size[p] = utils::rnd_up(
+                    (size_t)m_p * k_p * sizeof(int8_t), sizeof(float));
 #endif
             rnn.weights_layer_pack_size += rnn.n_layer * rnn.n_dir
                     * rnn.part_weights_layer_pack_size[p];
@@ -206,10 +226,9 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                         = cblas_gemm_s8u8s32_pack_get_size(
                                 CblasAMatrix, m_p, n_p, k_p);
 #else
-            UNUSED(m_p);
-            UNUSED(k_p);
             UNUSED(n_p);
-            rnn.part_weights_iter_pack_size[p] = 0;
+            rnn.part_weights_iter_pack_size[p] = utils::rnd_up(
+                    (size_t)m_p * k_p * sizeof(int8_t), sizeof(float));
 #endif
             rnn.weights_iter_pack_size += rnn.n_layer * rnn.n_dir
                     * rnn.part_weights_iter_pack_size[p];
@@ -219,6 +238,24 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                         * rnn.n_dir * rnn.n_gates * rnn.dic * sizeof(float);
     }
 
+    /* For small batches the LSTM gates of a block of dic fit in L1, so
+     * compute them and apply the elementwise part block by block instead of
+     * streaming the whole ws_gates twice. Blocks are sized to give every
+     * thread some of them */
+    rnn.use_fused_cell = rnn.is_fwd && is_inference && !is_int8
+            && rd.cell_desc.cell_kind == alg_kind::vanilla_lstm
+            && !rnn.is_lstm_peephole && !rnn.is_lstm_projection
+            && !rnn.use_layer_packed_gemm && !rnn.use_iter_packed_gemm
+            && rnn.mb <= 16;
+    rnn.fused_dic_block = nstl::min(128,
+            rnd_up(div_up(rnn.dic, mkldnn_get_max_threads()), 16));
+
+    /* When there is no concurrency across cells, keep the threads alive for
+     * the whole sequence rather than forking them for every cell. This needs
+     * threads that can wait for each other */
+    rnn.use_persistent = MKLDNN_THR_SYNC == 1 && rnn.use_fused_cell
+            && !rnn.use_wavefront && !rnn.use_seq_lengths && rnn.n_iter > 1
+            && mkldnn_get_max_threads() > 1;
 }
 
 void rnn_utils::set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
@@ -249,6 +286,9 @@ void rnn_utils::set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     };
     set_dims(weights_layer_d, rnn.weights_layer_ld, rnn.weights_layer_nld);
     set_dims(weights_iter_d, rnn.weights_iter_ld, rnn.weights_iter_nld);
+    /* the projection weights are dense ldio (see check_layout_consistency) */
+    rnn.weights_projection_ld = rnn.is_lstm_projection ? rnn.dic : 0;
+    rnn.weights_projection_nld = rnn.is_lstm_projection ? rnn.dic : 0;
     if (!rnn.is_fwd) {
         set_dims(diff_weights_layer_d, rnn.diff_weights_layer_ld,
                 rnn.diff_weights_layer_nld);
@@ -290,10 +330,39 @@ void rnn_utils::set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
             = rnn.is_lbr || rnn.dt_conf != all_f32
                 ? (size_t) rnn.gates_nld * rnn.gates_ws_ld * sizeof(float)
                 : 0;
+    /* the projection reads the hidden state from there before it writes the
+     * projected one to the states */
+    if (rnn.is_lstm_projection)
+        rnn.ws_cell_comp_size = nstl::max(rnn.ws_cell_comp_size,
+                (size_t)rnn.states_nld * rnn.states_ws_ld * sizeof(float));
+    /* cells of different layers and directions run concurrently, so each
+     * needs its own */
+    if (rnn.use_wavefront)
+        rnn.ws_cell_comp_size *= rnn.n_layer * rnn.n_dir;
     rnn.ws_grid_comp_size = (size_t)rnn.is_lbr * rnn.is_training * rnn.n_layer
             * rnn.n_dir * rnn.n_iter * rnn.ws_per_cell * sizeof(float);
     rnn.ws_bias_size = (size_t)rnn.n_layer * rnn.n_dir * rnn.n_bias * rnn.dic
             * sizeof(float);
+
+    /* Backward with checkpoints only has the gates and grid of the
+     * ws_checkpoint iterations it recomputes. The c states buffer holds the
+     * LSTM checkpoints, then the c states these iterations compute, then the
+     * hidden state the recomputation writes and does not need */
+    if (!rnn.is_fwd && rnn.ws_checkpoint) {
+        const size_t k = rnn.ws_checkpoint;
+        const size_t state_size
+                = (size_t)rnn.states_nld * rnn.states_ws_ld * sizeof(float);
+        const size_t n_c_states = is_lstm
+                ? (size_t)rnn.n_layer * rnn.n_dir
+                                * utils::div_up(rnn.n_iter, rnn.ws_checkpoint)
+                        + k
+                : 0;
+        rnn.ws_gates_size
+                = k * rnn.gates_nld * rnn.gates_ws_ld * sizeof(float);
+        rnn.ws_c_states_size = (n_c_states + 1) * state_size;
+        rnn.ws_grid_comp_size
+                = (size_t)rnn.is_lbr * k * rnn.ws_per_cell * sizeof(float);
+    }
 }
 
 int rnn_utils::get_good_ld(int dim, int sizeof_dt) {
@@ -337,13 +406,22 @@ void rnn_utils::set_offsets(const rnn_conf_t &rnn, size_t &ws_gates_offset,
     ws_cell_comp_offset = current_offset;
     current_offset += rnn.ws_cell_comp_size;
 
-    workspace_size = rnn.use_workspace ? current_offset : 0;
+    /* With a compact workspace these f32 buffers are in the scratchpad, and
+     * the workspace only has what backward needs */
+    const bool in_workspace
+            = rnn.use_workspace && !rnn.use_compact_workspace;
+    workspace_size = in_workspace ? current_offset : 0;
+    if (rnn.use_compact_workspace) {
+        size_t gates_offset, states_offset, c_states_offset, grid_offset;
+        set_compact_workspace_offsets(rnn, gates_offset, states_offset,
+                c_states_offset, grid_offset, workspace_size);
+    }
 
     /* Optional scratchpads */
     // Assumes the scratchpad base pointer is page aligned.
-    // If use_workspace, the following goes to scratchpad alone,
+    // If in_workspace, the following goes to scratchpad alone,
     // otherwise, all goes to scratchpad and continue incrementing offset
-    current_offset = rnn.use_workspace ? 0 : current_offset;
+    current_offset = in_workspace ? 0 : current_offset;
 
     if (rnn.copy_bias) {
         current_offset = utils::rnd_up(current_offset, page_size);
@@ -354,6 +432,57 @@ void rnn_utils::set_offsets(const rnn_conf_t &rnn, size_t &ws_gates_offset,
     scratchpad_size = current_offset;
 }
 
+/* The workspace is laid out the same for forward and backward, so the sizes
+ * are computed from the dimensions and not from the buffers backward runs
+ * on */
+void rnn_utils::set_compact_workspace_offsets(const rnn_conf_t &rnn,
+        size_t &ws_gates_offset, size_t &ws_states_offset,
+        size_t &ws_c_states_offset, size_t &ws_grid_comp_offset,
+        size_t &workspace_size) {
+    const size_t page_size = 4096;
+    const size_t dt_size
+            = rnn.use_f16_workspace ? sizeof(float16_t) : sizeof(float);
+    const size_t state_size = (size_t)rnn.states_nld * rnn.states_ws_ld;
+    const bool is_lstm = rnn.n_states == 2;
+
+    size_t gates_size = (size_t)rnn.n_layer * rnn.n_dir * rnn.n_iter
+            * rnn.gates_nld * rnn.gates_ws_ld;
+    size_t states_size
+            = (size_t)(rnn.n_layer + 1) * rnn.n_dir * (rnn.n_iter + 1)
+            * state_size;
+    size_t c_states_size = is_lstm ? states_size : 0;
+    size_t grid_size = (size_t)rnn.is_lbr * rnn.n_layer * rnn.n_dir
+            * rnn.n_iter * rnn.ws_per_cell;
+    if (rnn.ws_checkpoint) {
+        gates_size = 0;
+        c_states_size = is_lstm
+                ? (size_t)rnn.n_layer * rnn.n_dir
+                        * utils::div_up(rnn.n_iter, rnn.ws_checkpoint)
+                        * state_size
+                : 0;
+        grid_size = 0;
+    }
+
+    size_t current_offset = 0;
+
+    ws_gates_offset = current_offset;
+    current_offset += gates_size * dt_size;
+
+    current_offset = utils::rnd_up(current_offset, page_size);
+    ws_states_offset = current_offset;
+    current_offset += states_size * dt_size;
+
+    current_offset = utils::rnd_up(current_offset, page_size);
+    ws_c_states_offset = current_offset;
+    current_offset += c_states_size * dt_size;
+
+    current_offset = utils::rnd_up(current_offset, page_size);
+    ws_grid_comp_offset = current_offset;
+    current_offset += grid_size * dt_size;
+
+    workspace_size = current_offset;
+}
+
 void rnn_utils::get_scratchpad_and_workspace_sizes(const rnn_conf_t &rnn,
         size_t &scratchpad_size, size_t &workspace_size) {
     size_t ws_gates_offset, ws_states_offset, ws_c_states_offset,
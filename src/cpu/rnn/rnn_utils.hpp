@@ -26,14 +26,17 @@
             src_data_t *states_t_l_, float *c_states_t_l_,            \
             src_data_t *states_tm1_l_, float *c_states_tm1_l_,        \
             float *diff_states_t_l_, float *diff_states_t_lp1_,       \
-            float *diff_states_tp1_l_, float *bias_, float *ws_grid_, \
+            float *diff_states_tp1_l_, float *bias_,                  \
+            const float *weights_peephole_, float *ws_grid_,          \
             acc_data_t *ws_cell_) const
 
 #define rnn_cell_execution_sig(f)                                             \
     void f(const rnn_utils::rnn_conf_t &rnn, src_data_t *states_t_l_,     \
             float *c_states_t_l_, float *diff_states_t_l_,                \
             weights_data_t **w_layer_, weights_data_t **w_iter_,          \
-            float **bias_, src_data_t *states_t_lm1_,                     \
+            float **bias_, const float *w_peephole_,                      \
+            const weights_data_t *w_projection_,                          \
+            src_data_t *states_t_lm1_,                                    \
             src_data_t *states_tm1_l_, float *c_states_tm1_l_,            \
             float *diff_states_t_lp1_, float *diff_states_tp1_l_,         \
             float *diff_w_layer_, float *diff_w_iter_, float *diff_bias_, \
@@ -42,6 +45,8 @@
 #define rnn_grid_execution_sig(f)                                                 \
     void f(const rnn_utils::rnn_conf_t &rnn, weights_data_t **weights_layer_, \
             weights_data_t **weights_states_, float **bias_,                  \
+            const float *weights_peephole_,                                   \
+            const weights_data_t *weights_projection_, const int *seq_mb_,    \
             src_data_t *ws_states_, float *ws_c_states_,                      \
             float *ws_diff_states_, acc_data_t *ws_gates_, acc_data_t *ws_cell_,   \
             float *ws_grid_, float *diff_weights_layer_,                      \
@@ -117,13 +122,36 @@ struct rnn_conf_t {
     int states_nld, states_ws_ld;
     int weights_iter_compensation_size, weights_layer_compensation_size;
     bool is_fwd, is_training, is_lbr;
+    /* LSTM with peephole connections and with recurrent projection */
+    bool is_lstm_peephole, is_lstm_projection;
+    int weights_projection_ld, weights_projection_nld;
+    /* Sequences of different lengths, sorted by decreasing length and
+     * computed only on the first seq_mb[t] rows at time t */
+    bool use_seq_lengths;
     bool use_workspace;
+    /* The gates and states passed from forward training to backward are
+     * kept in f16 in the workspace, the cells run on f32 copies of them in
+     * the scratchpad */
+    bool use_f16_workspace;
+    /* Training only keeps the states, and the LSTM c states every
+     * ws_checkpoint iterations, in the workspace. Backward recomputes the
+     * gates of ws_checkpoint iterations at a time from them */
+    int ws_checkpoint;
+    /* The workspace does not hold the f32 layout the grid runs on */
+    bool use_compact_workspace;
 
     /* Size of workspace for each tensor in bytes */
     size_t ws_gates_size, ws_states_size, ws_c_states_size, ws_diff_states_size,
             ws_cell_comp_size, ws_grid_comp_size, ws_per_cell, ws_bias_size;
     bool merge_gemm_iter, merge_gemm_layer, use_jit_gemm, use_layer_packed_gemm,
         use_iter_packed_gemm;
+    /* Run the cells of each anti-diagonal of the grid concurrently */
+    bool use_wavefront;
+    /* Fuse the LSTM gemms and elementwise per block of fused_dic_block */
+    bool use_fused_cell;
+    int fused_dic_block;
+    /* Run each layer in one parallel region, with weights split by rows */
+    bool use_persistent;
 };
 
 bool is_ldigo(const memory_desc_wrapper &md);
@@ -150,6 +178,11 @@ void set_offsets(const rnn_conf_t &rnn, size_t &ws_gates_offset,
         size_t &ws_cell_comp_offset, size_t &ws_bias_offset,
         size_t &scratchpad_size, size_t &workspace_size);
 
+void set_compact_workspace_offsets(const rnn_conf_t &rnn,
+        size_t &ws_gates_offset, size_t &ws_h_state_offset,
+        size_t &ws_c_state_offset, size_t &ws_grid_comp_offset,
+        size_t &workspace_size);
+
 void get_scratchpad_and_workspace_sizes(const rnn_conf_t &rnn,
         size_t &scratchpad_size, size_t &workspace_size);
 status_t set_expected_desc(
@@ -171,6 +204,18 @@ private:
 using ws_gates_aoc_t = ws_gates_aoc<float>;
 using ws_gates_aoc_s32_t = ws_gates_aoc<int32_t>;
 
+struct weights_peephole_aoc_t {
+    weights_peephole_aoc_t(const rnn_conf_t &rnn, const float *data)
+        : weights_peephole_(data, 3, rnn.dic) {}
+    const float &operator()(int g, int dic) {
+        return weights_peephole_(g, dic);
+    }
+
+private:
+    mkldnn::impl::utils::array_offset_calculator<const float, 2>
+            weights_peephole_;
+};
+
 struct bias_aoc_t {
     bias_aoc_t(const rnn_conf_t &rnn, const float *data)
         : bias_(data, rnn.n_bias, rnn.dic) {}
@@ -131,6 +131,8 @@ struct _ref_rnn_common_t : public primitive_t {
                     && src_layer_dt == src_type
                     && everyone_is(
                                weights_type, weights_iter_dt, weights_layer_dt)
+                    && !this->with_peephole() && !this->with_projection()
+                    && !this->with_seq_lengths()
                     && this->set_default_params() == status::success
                     && IMPLICATION(src_type == data_type::f16,
                         this->desc()->prop_kind == forward_inference)
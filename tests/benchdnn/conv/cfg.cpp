@@ -230,6 +230,7 @@ const dt_conf_t *auto_cfg(const alg_t alg, const dt_conf_t *cfg) {
     CASE(u8s8s8s32);
     CASE(u8s8u8s32);
 #undef CASE
+    if (alg == FFT && !strcmp(cfg_s, "f32")) return conf_f32_wino;
     return cfg;
 }
 
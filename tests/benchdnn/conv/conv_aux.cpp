@@ -33,6 +33,7 @@ alg_t str2alg(const char *str) {
     CASE(AUTO);
     CASE(DIRECT);
     CASE(WINO);
+    CASE(FFT);
 #undef CASE
     assert(!"unknown algorithm");
     return DIRECT;
@@ -42,6 +43,7 @@ const char *alg2str(alg_t alg) {
     if (alg == AUTO) return "auto";
     if (alg == DIRECT) return "direct";
     if (alg == WINO) return "wino";
+    if (alg == FFT) return "fft";
     assert(!"unknown algorithm");
     return "unknown algorithm";
 }
@@ -50,6 +52,7 @@ alg_t alg_kind2alg(mkldnn_alg_kind_t alg) {
     if (alg == mkldnn_convolution_auto) return AUTO;
     if (alg == mkldnn_convolution_direct) return DIRECT;
     if (alg == mkldnn_convolution_winograd) return WINO;
+    if (alg == mkldnn_convolution_fft) return FFT;
     assert(!"unknown algorithm");
     return DIRECT;
 }
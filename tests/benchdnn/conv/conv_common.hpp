@@ -35,7 +35,7 @@ extern const char *perf_template; /* performance output template */
 
 namespace conv {
 
-enum alg_t { DIRECT, WINO, AUTO };
+enum alg_t { DIRECT, WINO, AUTO, FFT };
 alg_t str2alg(const char *str);
 const char *alg2str(alg_t alg);
 alg_t alg_kind2alg(mkldnn_alg_kind_t alg);
@@ -36,6 +36,7 @@ mkldnn_data_type_t str2dt(const char *str) {
     CASE(u8);
     CASE(s32);
     CASE(f32);
+    CASE(f16);
 #undef CASE
     assert(!"unknown data type");
     return mkldnn_f32;
@@ -136,6 +137,7 @@ mkldnn_format_tag_t str2tag(const char *str) {
     CASE(ldigo);
     CASE(ldgoi);
     CASE(ldgo);
+    CASE(ldio);
 #undef CASE
     assert(!"unknown memory format tag");
     return mkldnn_format_tag_undef;
@@ -40,6 +40,11 @@ const dt_conf_t *cfg = conf_f32;
 policy_t scale_policy = NONE;
 attr_t attr;
 bool allow_unimpl = false;
+bool with_peephole = false;
+bool with_projection = false;
+bool with_seq_lengths = false;
+mkldnn_data_type_t ws_dt = mkldnn_f32;
+int ws_checkpoint = 0;
 int mb = 0;
 
 void reset_parameters() {
@@ -51,6 +56,11 @@ void reset_parameters() {
     activation = RELU;
     scale_policy = NONE;
     allow_unimpl = false;
+    with_peephole = false;
+    with_projection = false;
+    with_seq_lengths = false;
+    ws_dt = mkldnn_f32;
+    ws_checkpoint = 0;
     mb = 0;
 }
 
@@ -78,6 +88,16 @@ int bench(int argc, char **argv, bool main_bench) {
             activation = str2activation(argv[arg] + 13);
         else if (!strncmp("--allow-unimpl=", argv[arg], 15))
             allow_unimpl = str2bool(argv[arg] + 15);
+        else if (!strncmp("--with-peephole=", argv[arg], 16))
+            with_peephole = str2bool(argv[arg] + 16);
+        else if (!strncmp("--with-projection=", argv[arg], 18))
+            with_projection = str2bool(argv[arg] + 18);
+        else if (!strncmp("--with-seq-lengths=", argv[arg], 19))
+            with_seq_lengths = str2bool(argv[arg] + 19);
+        else if (!strncmp("--ws-dt=", argv[arg], 8))
+            ws_dt = str2dt(argv[arg] + 8);
+        else if (!strncmp("--ws-checkpoint=", argv[arg], 16))
+            ws_checkpoint = atoi(argv[arg] + 16);
         else if (!strncmp("--scaling=", argv[arg], 10))
             scale_policy = str2policy(argv[arg] + 10);
         else if (!strncmp("--reset", argv[arg], 7))
@@ -112,7 +132,8 @@ int bench(int argc, char **argv, bool main_bench) {
 
 void check(rnn_desc_t *d) {
     const rnn_prb_t p(*d, cfg, prop, alg, direction, activation, attr,
-        scale_policy, mb);
+        scale_policy, with_peephole, with_projection, with_seq_lengths, ws_dt,
+        ws_checkpoint, mb);
     res_t res{};
     char pstr[max_prb_len];
 
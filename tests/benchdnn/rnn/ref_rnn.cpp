@@ -59,7 +59,52 @@ float activation(activation_t f, float x, bool is_fwd = true) {
     return result;
 }
 
-void rnn_fwd(activation_t f, int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batch,
+/* In int8 the workspace keeps the states as data_scale * h, and the gemms
+ * accumulate in the scale of the weights times data_scale */
+float maybe_deq_w(const rnn_prb_t *p, float g, int64_t oc) {
+    if (p->cfg == conf_f32 || p->cfg == conf_f16)
+        return g;
+    float scale = 1.;
+    if (p->scale_policy == PER_OC)
+        scale = p->wei_oc_scales[oc];
+    else if (p->scale_policy == COMMON)
+        scale = p->wei_scale;
+    scale *= p->data_scale;
+    return g / scale;
+}
+
+float maybe_deq_d(const rnn_prb_t *p, float h) {
+    if (p->cfg == conf_f32 || p->cfg == conf_f16)
+        return h;
+    return h / p->data_scale;
+}
+
+float maybe_q_d(const rnn_prb_t *p, float h) {
+    if (p->cfg == conf_f32 || p->cfg == conf_f16)
+        return h;
+    float fp = p->data_scale * h;
+    fp = mxcsr_round(fp);
+    if (fp + p->data_shift > p->cfg[input].max)
+        fp = p->cfg[input].max - p->data_shift;
+    if (fp + p->data_shift < p->cfg[input].min)
+        fp = p->cfg[input].min - p->data_shift;
+    return fp;
+}
+
+/* With the f16 workspace, backward gets the forward gates and states rounded
+ * to f16 */
+void maybe_round_ws(const rnn_prb_t *p, float *ws, int64_t size) {
+    if (p->ws_dt != mkldnn_f16)
+        return;
+    for (int64_t i = 0; i < size; i++) {
+        int e;
+        frexpf(ws[i], &e);
+        e = MAX2(e, -13); // f16 denormals are multiples of 2^-24
+        ws[i] = ldexpf(nearbyintf(ldexpf(ws[i], 11 - e)), e - 11);
+    }
+}
+
+void rnn_fwd(const rnn_prb_t *p, activation_t f, int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batch,
         int64_t n_gates, float *dst_iter_h_, float *gates_,
         const float *weights_layer_, const float *weights_iter_h_,
         const float *bias_, const float *src_layer_, const float *src_iter_h_) {
@@ -75,13 +120,15 @@ void rnn_fwd(activation_t f, int64_t sic, int64_t slc, int64_t dic, int64_t wc,
     for (int64_t i = 0; i < batch; i++)
         for (int64_t j = 0; j < n_gates; j++)
             for (int64_t k = 0; k < dic; k++) {
-                const auto tmp = activation(f, gates(i, j, k) + bias(j, k));
+                const auto tmp = activation(f,
+                        maybe_deq_w(p, gates(i, j, k), j * dic + k)
+                                + bias(j, k));
                 gates(i, j, k) = tmp;
-                dst_iter_h(i, j, k) = tmp;
+                dst_iter_h(i, j, k) = maybe_q_d(p, tmp);
             }
 }
 
-void gru_fwd(int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batch, int64_t n_gates,
+void gru_fwd(const rnn_prb_t *p, int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batch, int64_t n_gates,
         float *dst_iter_h_, float *gates_, const float *weights_layer_,
         const float *weights_iter_h_, const float *bias_,
         const float *src_layer_, const float *src_iter_h_) {
@@ -99,12 +146,15 @@ void gru_fwd(int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batch, i
     for (int64_t i = 0; i < batch; i++)
         for (int64_t j = 0; j < n_gates - 1; j++)
             for (int64_t k = 0; k < dic; k++) {
-                gates(i, j, k) = logistic(gates(i, j, k) + bias(j, k));
+                gates(i, j, k) = logistic(
+                        maybe_deq_w(p, gates(i, j, k), j * dic + k)
+                        + bias(j, k));
             }
 
     for (int64_t i = 0; i < batch; i++)
         for (int64_t k = 0; k < dic; k++) {
-            h_dst(i, k) = src_iter_h(i, k) * gates(i, 1, k);
+            h_dst(i, k) = maybe_q_d(p,
+                    maybe_deq_d(p, src_iter_h(i, k)) * gates(i, 1, k));
         }
 
     gemm("C", "N", "N", batch, dic, sic, 1.0, dst_iter_h_, wc,
@@ -113,17 +163,19 @@ void gru_fwd(int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batch, i
 
     for (int64_t i = 0; i < batch; i++)
         for (int64_t k = 0; k < dic; k++) {
-            gates(i, 2, k) = tanhf(gates(i, 2, k) + bias(2, k));
+            gates(i, 2, k) = tanhf(
+                    maybe_deq_w(p, gates(i, 2, k), 2 * dic + k) + bias(2, k));
         }
 
     for (int64_t i = 0; i < batch; i++)
         for (int64_t k = 0; k < dic; k++) {
-            h_dst(i, k) = gates(i, 0, k) * src_iter_h(i, k) +
-                (1 - gates(i, 0, k)) * gates(i, 2, k);
+            h_dst(i, k) = maybe_q_d(p,
+                    gates(i, 0, k) * maybe_deq_d(p, src_iter_h(i, k))
+                    + (1 - gates(i, 0, k)) * gates(i, 2, k));
         }
 }
 
-void gru_lbr_fwd(int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batch, int64_t n_gates,
+void gru_lbr_fwd(const rnn_prb_t *p, int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batch, int64_t n_gates,
         float *dst_iter_h_, float *gates_, const float *weights_layer_,
         const float *weights_iter_h_, const float *bias_,
         const float *src_layer_, const float *src_iter_h_,
@@ -145,20 +197,24 @@ void gru_lbr_fwd(int64_t sic, int64_t slc, int64_t dic, int64_t wc, int64_t batc
     for (int64_t i = 0; i < batch; i++)
         for (int64_t j = 0; j < n_gates - 1; j++)
             for (int64_t k = 0; k < dic; k++) {
-                gates(i, j, k) = logistic(gates(i, j, k) + tmp_ws(i, j, k)
-                    + bias(j, k));
+                gates(i, j, k) = logistic(
+                        maybe_deq_w(p, gates(i, j, k), j * dic + k)
+                        + maybe_deq_w(p, tmp_ws(i, j, k), j * dic + k)
+                        + bias(j, k));
             }
 
     for (int64_t i = 0; i < batch; i++)
         for (int64_t k = 0; k < dic; k++) {
-            gates(i, 2, k) = tanhf(gates(i, 2, k) + gates(i, 1, k) * (tmp_ws(i, 2, k)
+            gates(i, 2, k) = tanhf(maybe_deq_w(p, gates(i, 2, k), 2 * dic + k)
+                + gates(i, 1, k) * (maybe_deq_w(p, tmp_ws(i, 2, k), 2 * dic + k)
                 + bias(3, k)) + bias(2, k));
         }
 
     for (int64_t i = 0; i < batch; i++)
         for (int64_t k = 0; k < dic; k++) {
-            h_dst(i, k) = gates(i, 0, k) * src_iter_h(i, k) +
-                (1 - gates(i, 0, k)) * gates(i, 2, k);
+            h_dst(i, k) = maybe_q_d(p,
+                    gates(i, 0, k) * maybe_deq_d(p, src_iter_h(i, k))
+                    + (1 - gates(i, 0, k)) * gates(i, 2, k));
         }
 
 }
@@ -168,7 +224,8 @@ void lstm_fwd(const rnn_prb_t *p, int64_t sic, int64_t slc, int64_t dic, int64_t
         int64_t n_gates, float *dst_iter_h_, float *c_dst_, float *gates_,
         const float *weights_layer_, const float *weights_iter_h_,
         const float *bias_, const float *src_layer_, const float *src_iter_h_,
-        const float *src_iter_c_) {
+        const float *src_iter_c_, const float *weights_peephole_,
+        const float *weights_projection_) {
     AOC<float> h_dst(dst_iter_h_, batch, wc);
     AOC<float> c_dst(c_dst_, batch, wc);
     AOC<const float> bias(bias_, n_gates, dic);
@@ -185,73 +242,77 @@ void lstm_fwd(const rnn_prb_t *p, int64_t sic, int64_t slc, int64_t dic, int64_t
     gemm("C", "N", "N", batch, n_gates * dic, sic, 1.0, src_iter_h_, wc,
             weights_iter_h_, n_gates * dic, 1.0, gates_, n_gates * dic);
 
-    auto maybe_deq_w = [&](float g, int64_t oc) {
-        if (p->cfg == conf_f32 || p->cfg == conf_f16)
-            return g;
-        float scale = 1.;
-        if (p->scale_policy == PER_OC)
-            scale = p->wei_oc_scales[oc];
-        else if (p->scale_policy == COMMON)
-            scale = p->wei_scale;
-        scale *= p->data_scale;
-        return g / scale;
-    };
-
     // add bias
     for (int64_t i = 0; i < batch; i++)
         for (int64_t j = 0; j < n_gates; j++)
             for (int64_t k = 0; k < dic; k++) {
                 gates(i, j, k)
-                        = maybe_deq_w(gates(i, j, k), j * dic + k) + bias(j, k);
+                        = maybe_deq_w(p, gates(i, j, k), j * dic + k) + bias(j, k);
+            }
+
+    // peephole: i and f see c_{t-1}, o sees c_t
+    if (weights_peephole_) {
+        AOC<const float> weights_peephole(weights_peephole_, 3, dic);
+        for (int64_t i = 0; i < batch; i++)
+            for (int64_t j = 0; j < dic; j++) {
+                gates(i, ohi, j) += weights_peephole(0, j) * src_iter_c(i, j);
+                gates(i, ohf, j) += weights_peephole(1, j) * src_iter_c(i, j);
+                float c = logistic(gates(i, ohf, j)) * src_iter_c(i, j)
+                        + logistic(gates(i, ohi, j))
+                                * tanhf(gates(i, ohc, j));
+                gates(i, oho, j) += weights_peephole(2, j) * c;
             }
+    }
 
     // run the eltwise
     lstm_activation(dic, n_gates, batch, gates_);
 
-    auto maybe_q_d = [&](float h) {
-        if (p->cfg == conf_f32 || p->cfg == conf_f16)
-            return h;
-        float fp = p->data_scale * h;
-        fp = mxcsr_round(fp);
-        if (fp + p->data_shift > p->cfg[input].max)
-            fp = p->cfg[input].max - p->data_shift;
-        if (fp + p->data_shift < p->cfg[input].min)
-            fp = p->cfg[input].min - p->data_shift;
-        return fp;
-    };
-
     // compute C_t_l and H_t_l
     for (int64_t i = 0; i < batch; i++)
         for (int64_t j = 0; j < dic; j++) {
             float tmp = gates(i, ohf, j) * src_iter_c(i, j)
                     + gates(i, ohi, j) * gates(i, ohc, j);
             c_dst(i, j) = tmp;
-            h_dst(i, j) = maybe_q_d(gates(i, oho, j) * tanhf(tmp));
+            h_dst(i, j) = maybe_q_d(p, gates(i, oho, j) * tanhf(tmp));
         }
+
+    // projection: h_t = h_t * weights_projection, only in f32
+    if (weights_projection_) {
+        float *h_ = new float[batch * dic];
+        AOC<float> h(h_, batch, dic);
+        for (int64_t i = 0; i < batch; i++)
+            for (int64_t j = 0; j < dic; j++)
+                h(i, j) = h_dst(i, j);
+        gemm("C", "N", "N", batch, dic, dic, 1.0, h_, dic, weights_projection_,
+                dic, 0.0, dst_iter_h_, wc);
+        delete[] h_;
+    }
 }
 
 void rnn_cell_fwd(const rnn_prb_t *p, alg_t alg, activation_t f, int64_t sic,
         int64_t slc, int64_t dic, int64_t wc, int64_t batch, int64_t n_gates, float *dst_iter_h,
         float *dst_iter_c, float *gates, const float *weights_layer,
         const float *weights_iter, const float *bias, const float *src_layer,
-        const float *src_iter_h, const float *src_iter_c, float *ws_local_) {
+        const float *src_iter_h, const float *src_iter_c,
+        const float *weights_peephole, const float *weights_projection,
+        float *ws_local_) {
     switch (alg) {
     case VANILLA_GRU:
-        gru_fwd(sic, slc, dic, wc, batch, n_gates, dst_iter_h, gates,
+        gru_fwd(p, sic, slc, dic, wc, batch, n_gates, dst_iter_h, gates,
                 weights_layer, weights_iter, bias, src_layer, src_iter_h);
         break;
     case LBR_GRU:
-        gru_lbr_fwd(sic, slc, dic, wc, batch, n_gates, dst_iter_h, gates,
+        gru_lbr_fwd(p, sic, slc, dic, wc, batch, n_gates, dst_iter_h, gates,
                 weights_layer, weights_iter, bias, src_layer, src_iter_h,
                 ws_local_);
         break;
     case VANILLA_LSTM:
         lstm_fwd(p, sic, slc, dic, wc, batch, n_gates, dst_iter_h, dst_iter_c,
                 gates, weights_layer, weights_iter, bias, src_layer, src_iter_h,
-                src_iter_c);
+                src_iter_c, weights_peephole, weights_projection);
         break;
     case VANILLA_RNN:
-        rnn_fwd(f, sic, slc, dic, wc, batch, n_gates, dst_iter_h, gates,
+        rnn_fwd(p, f, sic, slc, dic, wc, batch, n_gates, dst_iter_h, gates,
                 weights_layer, weights_iter, bias, src_layer, src_iter_h);
         break;
     default: break;
@@ -483,8 +544,9 @@ void copy_res_bwd(alg_t alg, int64_t sic, int64_t slc, int64_t dic, int64_t dlc,
 void rnn_linear_fwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
         const float *src_iter_, const float *src_layer_,
         const float *weights_layer_, const float *weights_iter_h_,
-        const float *bias_, float *dst_iter_, float *dst_layer_, float *ws_,
-        float *gates_) {
+        const float *bias_, const float *weights_peephole_,
+        const float *weights_projection_, float *dst_iter_, float *dst_layer_,
+        float *ws_, float *gates_) {
 
     const alg_t alg = p->alg;
     const int64_t sic = p->sic;
@@ -508,6 +570,10 @@ void rnn_linear_fwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
             weights_layer_, n_layer, n_dir, n_gates * dic, slc);
     AOC<const float> weights_iter(
             weights_iter_h_, n_layer, n_dir, n_gates * dic, sic);
+    AOC<const float> weights_peephole(
+            weights_peephole_, n_layer, n_dir, 3 * dic);
+    AOC<const float> weights_projection(
+            weights_projection_, n_layer, n_dir, dic * dic);
     AOC<float> ws(ws_, n_layer + 2, n_dir, n_iter + 2, n_states, batch, wc);
     AOC<float> gates(gates_, n_layer, n_dir, n_iter, batch, n_gates, dic);
 
@@ -539,7 +605,24 @@ void rnn_linear_fwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
                         &bias(lay - 1, dir_val, 0),
                         &ws(lay - 1, dir_val, iter, H, 0, 0),
                         &ws(lay, dir_val, prev_iter, H, 0, 0),
-                        &ws(lay, dir_val, prev_iter, C, 0, 0), ws_local_);
+                        &ws(lay, dir_val, prev_iter, C, 0, 0),
+                        weights_peephole_
+                                ? &weights_peephole(lay - 1, dir_val, 0)
+                                : nullptr,
+                        weights_projection_
+                                ? &weights_projection(lay - 1, dir_val, 0)
+                                : nullptr,
+                        ws_local_);
+
+                // ended sequences keep their last states
+                for (int64_t b = 0; b < batch; b++) {
+                    if (iter - 1 < p->seq_length(b))
+                        continue;
+                    for (int64_t s = 0; s < n_states; s++)
+                        for (int64_t c = 0; c < wc; c++)
+                            ws(lay, dir_val, iter, s, b, c)
+                                    = ws(lay, dir_val, prev_iter, s, b, c);
+                }
             }
         }
 
@@ -567,12 +650,24 @@ void rnn_linear_fwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
     default: assert("unknown direction"); break;
     }
 
+    // the output is zero past the end of each sequence
+    const int64_t dst_layer_c = is_concat ? 2 * dlc : dlc;
+    const float dst_layer_zero = p->cfg[dst_last_layer].dt == mkldnn_u8
+            ? p->data_shift : 0.f;
+    AOC<float> dst_layer(dst_layer_, n_iter, batch, dst_layer_c);
+    for (int64_t it = 0; it < n_iter; it++)
+        for (int64_t b = 0; b < batch; b++)
+            if (it >= p->seq_length(b))
+                for (int64_t c = 0; c < dst_layer_c; c++)
+                    dst_layer(it, b, c) = dst_layer_zero;
+
     delete[] ws_local_;
 }
 
 void compute_ref_fwd(const rnn_prb_t *p, dnn_mem_t &src_layer_m,
         dnn_mem_t &src_iter_m, dnn_mem_t &weights_src_layer_m,
         dnn_mem_t &weights_src_iter_m, dnn_mem_t &bias_m,
+        dnn_mem_t &weights_peephole_m, dnn_mem_t &weights_projection_m,
         dnn_mem_t &dst_last_layer_m, dnn_mem_t &dst_last_iteration_m,
         mkldnn_rnn_direction_t direction) {
 
@@ -591,8 +686,11 @@ void compute_ref_fwd(const rnn_prb_t *p, dnn_mem_t &src_layer_m,
 
     rnn_linear_fwd(p, direction, (float *)src_iter_m, (float *)src_layer_m,
             (float *)weights_src_layer_m, (float *)weights_src_iter_m,
-            (float *)bias_m, (float *)dst_last_iteration_m,
-            (float *)dst_last_layer_m, ws, gates);
+            (float *)bias_m,
+            p->with_peephole ? (float *)weights_peephole_m : nullptr,
+            p->with_projection ? (float *)weights_projection_m : nullptr,
+            (float *)dst_last_iteration_m, (float *)dst_last_layer_m, ws,
+            gates);
 
     delete[] ws;
     delete[] gates;
@@ -1077,9 +1175,12 @@ void compute_ref_bwd(const rnn_prb_t *p, dnn_mem_t &input_m,
 
     rnn_linear_fwd(p, direction, (float *)states_m, (float *)input_m,
             (float *)weights_input_m, (float *)weights_states_m,
-            (float *)bias_m, (float *)dst_last_iteration_m,
+            (float *)bias_m, nullptr, nullptr, (float *)dst_last_iteration_m,
             (float *)dst_last_layer_m, ws, gates);
 
+    maybe_round_ws(p, ws, ws_size);
+    maybe_round_ws(p, gates, gates_size);
+
     rnn_linear_bwd(p, direction, (float *)diff_last_iteration_m,
             (float *)diff_last_layer_m, (float *)weights_input_m,
             (float *)weights_states_m, (float *)bias_m,
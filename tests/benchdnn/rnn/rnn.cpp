@@ -52,6 +52,14 @@ mkldnn_primitive_attr_t create_mkldnn_rnn_attr(const rnn_prb_t *p) {
                 mkldnn_attr, p->data_scale, p->data_shift));
     }
 
+    if (p->ws_dt != mkldnn_f32)
+        DNN_SAFE_V(mkldnn_primitive_attr_set_rnn_workspace_data_type(
+                mkldnn_attr, p->ws_dt));
+
+    if (p->ws_checkpoint != 0)
+        DNN_SAFE_V(mkldnn_primitive_attr_set_rnn_workspace_checkpoint(
+                mkldnn_attr, p->ws_checkpoint));
+
     return mkldnn_attr;
 }
 
@@ -64,7 +72,8 @@ int fill_memory(const rnn_prb_t *p, rnn_data_kind_t kind, dnn_mem_t &mem1,
     const size_t nelems = mem2.nelems();
 #endif
 
-    dt_conf_t c = p->cfg[kind];
+    // peephole weights are f32 for every configuration
+    dt_conf_t c = kind == weights_peephole ? conf_f32[kind] : p->cfg[kind];
     float mean = c.f_mean, var = c.f_var, min = c.f_min, max = c.f_max;
     mkldnn::impl::parallel(0, [&](int ithr, int nthr) {
         size_t chunk_size = (nelems + nthr - 1) / nthr;
@@ -96,7 +105,8 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
     mkldnn_memory_desc_t input_d, states_d, weights_input_d, weights_states_d,
             bias_d, dst_last_layer_d, dst_last_iteration_d, diff_input_d,
             diff_states_d, diff_weights_input_d, diff_weights_states_d,
-            diff_bias_d, diff_last_layer_d, diff_last_iteration_d;
+            diff_bias_d, diff_last_layer_d, diff_last_iteration_d,
+            weights_peephole_d, weights_projection_d;
 
     // dimensions with ref
     mkldnn_dims_t input_dims = { p->n_iter, p->mb, p->slc };
@@ -145,6 +155,23 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
                      &bias_d, 4, bias_dims, p->cfg[bias].dt, mkldnn_format_tag_any),
             WARN);
 
+    // the projection keeps the size of the hidden state
+    mkldnn_dims_t weights_peephole_dims
+            = { p->n_layer, p->n_directions(), 3, p->dic };
+    mkldnn_dims_t weights_projection_dims
+            = { p->n_layer, p->n_directions(), p->dic, p->dic };
+    weights_peephole_d = weights_projection_d = mkldnn_memory_desc_t();
+    if (p->with_peephole)
+        DNN_SAFE(mkldnn_memory_desc_init_by_tag(&weights_peephole_d, 4,
+                         weights_peephole_dims, mkldnn_f32,
+                         mkldnn_format_tag_any),
+                WARN);
+    if (p->with_projection)
+        DNN_SAFE(mkldnn_memory_desc_init_by_tag(&weights_projection_d, 4,
+                         weights_projection_dims, p->cfg[weights_states].dt,
+                         mkldnn_format_tag_any),
+                WARN);
+
     DNN_SAFE(mkldnn_memory_desc_init_by_tag(&dst_last_layer_d, 3, dst_last_layer_dims,
                      p->cfg[dst_last_layer].dt, mkldnn_tnc),
             WARN);
@@ -178,16 +205,34 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
     // When training, we use forward_training
     {
         mkldnn_status_t init_status = mkldnn_success;
-        init_status = mkldnn_rnn_forward_desc_init(&rd[0], fwd_prop, &rcd,
-                         p->direction, &input_d, &states_d, &weights_input_d,
-                         &weights_states_d, &bias_d, &dst_last_layer_d,
-                         &dst_last_iteration_d);
+        if (p->with_peephole || p->with_projection)
+            init_status = mkldnn_lstm_forward_desc_init(&rd[0], fwd_prop, &rcd,
+                    p->direction, &input_d, &states_d, &weights_input_d,
+                    &weights_states_d, &weights_peephole_d,
+                    &weights_projection_d, &bias_d, &dst_last_layer_d,
+                    &dst_last_iteration_d);
+        else
+            init_status = mkldnn_rnn_forward_desc_init(&rd[0], fwd_prop, &rcd,
+                    p->direction, &input_d, &states_d, &weights_input_d,
+                    &weights_states_d, &bias_d, &dst_last_layer_d,
+                    &dst_last_iteration_d);
         if (init_status == mkldnn_unimplemented)
             return r->state = UNIMPLEMENTED, OK;
         else
             SAFE(init_status, WARN);
     }
 
+    if (p->with_seq_lengths) {
+        mkldnn_memory_desc_t seq_lengths_d;
+        mkldnn_dims_t seq_lengths_dims = { p->mb };
+        DNN_SAFE(mkldnn_memory_desc_init_by_tag(&seq_lengths_d, 1,
+                         seq_lengths_dims, mkldnn_s32, mkldnn_format_tag_any),
+                WARN);
+        DNN_SAFE(mkldnn_rnn_forward_desc_set_seq_lengths(
+                         &rd[0], &seq_lengths_d),
+                WARN);
+    }
+
     if (is_bwd) {
         DNN_SAFE(mkldnn_memory_desc_init_by_tag(&diff_input_d, 3, input_dims,
                          p->cfg[dst_diff_input].dt, mkldnn_format_tag_any),
@@ -247,6 +292,12 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
         rd[i].dst_layer_desc = q(mkldnn_query_dst_md, i);
         rd[i].dst_iter_desc = q(mkldnn_query_dst_md, i, 1);
     }
+    if (p->with_peephole)
+        rd[0].weights_peephole_desc = q(mkldnn_query_weights_md, 0, 3);
+    if (p->with_projection)
+        rd[0].weights_projection_desc = q(mkldnn_query_weights_md, 0, 4);
+    if (p->with_seq_lengths)
+        rd[0].seq_lengths_desc = q(mkldnn_query_src_md, 0, 2);
     if (is_bwd) {
         rd[1].diff_src_layer_desc = q(mkldnn_query_diff_src_md, 1);
         rd[1].diff_src_iter_desc = q(mkldnn_query_diff_src_md, 1, 1);
@@ -275,6 +326,19 @@ int doit(const rnn_prb_t *p, res_t *r) {
 
     const bool is_bwd = p->prop == mkldnn_backward;
 
+    // peephole and projection are LSTM forward only
+    if ((p->with_peephole || p->with_projection)
+            && (p->alg != VANILLA_LSTM || is_bwd)) {
+        r->state = UNIMPLEMENTED;
+        return OK;
+    }
+
+    // sequence lengths are forward only
+    if (p->with_seq_lengths && is_bwd) {
+        r->state = UNIMPLEMENTED;
+        return OK;
+    }
+
     dnn_mem_t *input_dt = nullptr;
     dnn_mem_t *states_dt = nullptr;
     dnn_mem_t *weights_input_dt = nullptr;
@@ -282,6 +346,9 @@ int doit(const rnn_prb_t *p, res_t *r) {
     dnn_mem_t *bias_dt = nullptr;
     dnn_mem_t *dst_last_layer_dt = nullptr;
     dnn_mem_t *dst_last_iteration_dt = nullptr;
+    dnn_mem_t *weights_peephole_dt = nullptr;
+    dnn_mem_t *weights_projection_dt = nullptr;
+    dnn_mem_t *seq_lengths_dt = nullptr;
 
     dnn_mem_t *bwd_weights_input_dt = nullptr;
     dnn_mem_t *bwd_weights_states_dt = nullptr;
@@ -300,6 +367,8 @@ int doit(const rnn_prb_t *p, res_t *r) {
     dnn_mem_t *bias_fp = nullptr;
     dnn_mem_t *dst_last_layer_fp = nullptr;
     dnn_mem_t *dst_last_iteration_fp = nullptr;
+    dnn_mem_t *weights_peephole_fp = nullptr;
+    dnn_mem_t *weights_projection_fp = nullptr;
 
     dnn_mem_t *dst_diff_input_fp = nullptr;
     dnn_mem_t *dst_diff_states_fp = nullptr;
@@ -347,6 +416,15 @@ int doit(const rnn_prb_t *p, res_t *r) {
             dst_last_layer_dt_d, p->cfg[dst_last_layer].dt, engine_tgt);
     dst_last_iteration_dt = new dnn_mem_t(
             dst_last_iteration_dt_d, p->cfg[dst_last_iteration].dt, engine_tgt);
+    if (p->with_peephole)
+        weights_peephole_dt = new dnn_mem_t(
+                rd[0].weights_peephole_desc, fp, engine_tgt);
+    if (p->with_projection)
+        weights_projection_dt = new dnn_mem_t(rd[0].weights_projection_desc,
+                p->cfg[weights_states].dt, engine_tgt);
+    if (p->with_seq_lengths)
+        seq_lengths_dt = new dnn_mem_t(
+                rd[0].seq_lengths_desc, mkldnn_s32, engine_tgt);
 
     if (is_bwd) {
         bwd_weights_input_dt
@@ -376,6 +454,15 @@ int doit(const rnn_prb_t *p, res_t *r) {
             = new dnn_mem_t(dst_last_layer_dt_d, fp, mkldnn_tnc, engine_ref);
     dst_last_iteration_fp = new dnn_mem_t(
             dst_last_iteration_dt_d, fp, mkldnn_ldsnc, engine_ref);
+    // the reference takes these even when unused, so they always exist
+    mkldnn_dims_t weights_peephole_dims
+            = { p->n_layer, p->n_directions(), 3, p->dic };
+    mkldnn_dims_t weights_projection_dims
+            = { p->n_layer, p->n_directions(), p->dic, p->dic };
+    weights_peephole_fp = new dnn_mem_t(
+            4, weights_peephole_dims, fp, mkldnn_ldgo, engine_ref);
+    weights_projection_fp = new dnn_mem_t(
+            4, weights_projection_dims, fp, mkldnn_ldio, engine_ref);
 
     if (is_bwd) {
         dst_diff_input_fp = new dnn_mem_t(
@@ -411,6 +498,20 @@ int doit(const rnn_prb_t *p, res_t *r) {
     SAFE(fill_memory(p, dst_last_iteration, *dst_last_iteration_dt,
                  *dst_last_iteration_fp),
             WARN);
+    if (p->with_peephole)
+        SAFE(fill_memory(p, weights_peephole, *weights_peephole_dt,
+                     *weights_peephole_fp),
+                WARN);
+    if (p->with_projection)
+        SAFE(fill_memory(p, weights_projection, *weights_projection_dt,
+                     *weights_projection_fp),
+                WARN);
+    if (p->with_seq_lengths) {
+        seq_lengths_dt->map();
+        for (int64_t b = 0; b < p->mb; b++)
+            seq_lengths_dt->set_elem(b, p->seq_length(b));
+        seq_lengths_dt->unmap();
+    }
 
     if (is_bwd) {
         SAFE(bwd_weights_states_dt->reorder(*weights_states_dt), WARN);
@@ -450,6 +551,12 @@ int doit(const rnn_prb_t *p, res_t *r) {
         args.set(MKLDNN_ARG_WEIGHTS_LAYER, weights_input_dt->m_);
         args.set(MKLDNN_ARG_WEIGHTS_ITER, weights_states_dt->m_);
         args.set(MKLDNN_ARG_BIAS, bias_dt->m_);
+        if (p->with_peephole)
+            args.set(MKLDNN_ARG_WEIGHTS_PEEPHOLE, weights_peephole_dt->m_);
+        if (p->with_projection)
+            args.set(MKLDNN_ARG_WEIGHTS_PROJECTION, weights_projection_dt->m_);
+        if (p->with_seq_lengths)
+            args.set(MKLDNN_ARG_SRC_SEQ_LENGTHS, seq_lengths_dt->m_);
 
         args.set(MKLDNN_ARG_DST_LAYER, dst_last_layer_dt->m_);
         args.set(MKLDNN_ARG_DST_ITER, dst_last_iteration_dt->m_);
@@ -461,7 +568,8 @@ int doit(const rnn_prb_t *p, res_t *r) {
 #endif
         if ((p->prop == mkldnn_forward) && (bench_mode & CORR)) {
             compute_ref_fwd(p, *input_fp, *states_fp, *weights_input_fp,
-                    *weights_states_fp, *bias_fp, *dst_last_layer_fp,
+                    *weights_states_fp, *bias_fp, *weights_peephole_fp,
+                    *weights_projection_fp, *dst_last_layer_fp,
                     *dst_last_iteration_fp, p->direction);
             dnn_mem_t dst_last_layer(
                     *dst_last_layer_dt, fp, mkldnn_tnc, engine_ref);
@@ -574,6 +682,8 @@ int doit(const rnn_prb_t *p, res_t *r) {
     delete bias_fp;
     delete dst_last_layer_fp;
     delete dst_last_iteration_fp;
+    delete weights_peephole_fp;
+    delete weights_projection_fp;
 
     if (is_bwd) {
         delete bwd_weights_input_dt;
@@ -594,6 +704,9 @@ int doit(const rnn_prb_t *p, res_t *r) {
     delete bias_dt;
     delete dst_last_layer_dt;
     delete dst_last_iteration_dt;
+    delete weights_peephole_dt;
+    delete weights_projection_dt;
+    delete seq_lengths_dt;
 
     if (is_bwd) {
         delete dst_diff_input_dt;
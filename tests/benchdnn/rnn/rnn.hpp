@@ -118,6 +118,8 @@ enum rnn_data_kind_t {
     dst_diff_bias,
     diff_last_iteration,
     diff_last_layer,
+    weights_peephole,
+    weights_projection,
     data_kind_total // should be last to provide the total number of data kinds
 };
 
@@ -130,6 +132,8 @@ inline const char *rnn_data_kind2str(rnn_data_kind_t kind) {
     case bias: return "BIAS";
     case dst_last_layer: return "DST_LAST_LAYER";
     case dst_last_iteration: return "DST_LAST_ITERATION";
+    case weights_peephole: return "WEIGHTS_PEEPHOLE";
+    case weights_projection: return "WEIGHTS_PROJECTION";
     default:
         assert(!"incorrect rnn data kind");
         return "incorrect rnn data kind";
@@ -176,7 +180,9 @@ struct rnn_prb_t : public rnn_desc_t {
     rnn_prb_t(const rnn_desc_t desc, const dt_conf_t *cfg,
             mkldnn_prop_kind_t prop, alg_t alg,
             mkldnn_rnn_direction_t direction, activation_t activation,
-            const attr_t &attr, policy_t scale_policy, int mb = 0)
+            const attr_t &attr, policy_t scale_policy, bool with_peephole,
+            bool with_projection, bool with_seq_lengths,
+            mkldnn_data_type_t ws_dt, int ws_checkpoint, int mb = 0)
         : rnn_desc_t(desc)
         , cfg(cfg)
         , prop(prop)
@@ -185,6 +191,11 @@ struct rnn_prb_t : public rnn_desc_t {
         , activation(activation)
         , attr(attr)
         , scale_policy(scale_policy)
+        , with_peephole(with_peephole)
+        , with_projection(with_projection)
+        , with_seq_lengths(with_seq_lengths)
+        , ws_dt(ws_dt)
+        , ws_checkpoint(ws_checkpoint)
         , ops(0.0) {
         count_ops();
         if (mb) this->mb = mb;
@@ -204,6 +215,8 @@ struct rnn_prb_t : public rnn_desc_t {
         // theoretical number of ops for the post-gemm operations
         int64_t num_cells = (int64_t) n_directions() * n_layer * n_iter;
         int64_t cell_ops = (int64_t) 2 * (n_gates() * dic) * mb * (sic + slc);
+        if (with_projection)
+            cell_ops += (int64_t) 2 * dic * mb * dic;
         ops = num_cells * cell_ops;
     }
 
@@ -223,6 +236,10 @@ struct rnn_prb_t : public rnn_desc_t {
     int64_t n_bias() const {
         return alg == LBR_GRU ? n_gates() + 1 : n_gates();
     }
+    // lengths in [1, n_iter], in no particular order
+    int64_t seq_length(int64_t b) const {
+        return with_seq_lengths ? 1 + (b * 5 + 2) % n_iter : n_iter;
+    }
 
     const dt_conf_t *cfg;
     mkldnn_prop_kind_t prop;
@@ -231,6 +248,11 @@ struct rnn_prb_t : public rnn_desc_t {
     activation_t activation;
     attr_t attr;
     policy_t scale_policy;
+    bool with_peephole;
+    bool with_projection;
+    bool with_seq_lengths;
+    mkldnn_data_type_t ws_dt;
+    int ws_checkpoint;
 
     double ops;
 
@@ -250,6 +272,7 @@ void prb2str(const rnn_prb_t *p, const res_t *res, char *buffer);
 void compute_ref_fwd(const rnn_prb_t *p, dnn_mem_t &input_m,
         dnn_mem_t &states_m, dnn_mem_t &weights_input_m,
         dnn_mem_t &weights_states_m, dnn_mem_t &bias_m,
+        dnn_mem_t &weights_peephole_m, dnn_mem_t &weights_projection_m,
         dnn_mem_t &dst_last_layer_m, dnn_mem_t &dst_last_iteration_m,
         mkldnn_rnn_direction_t direction);
 
@@ -227,6 +227,16 @@ void prb2str(const rnn_prb_t *p, const res_t *res, char *buffer) {
             prop2str(p->prop), alg2str(p->alg), activation2str(p->activation),
             direction2str(p->direction), cfg2str(p->cfg),
             policy2str(p->scale_policy));
+    if (p->with_peephole)
+        DPRINT("--with-peephole=true ");
+    if (p->with_projection)
+        DPRINT("--with-projection=true ");
+    if (p->with_seq_lengths)
+        DPRINT("--with-seq-lengths=true ");
+    if (p->ws_dt != mkldnn_f32)
+        DPRINT("--ws-dt=%s ", dt2str(p->ws_dt));
+    if (p->ws_checkpoint != 0)
+        DPRINT("--ws-checkpoint=%d ", p->ws_checkpoint);
     DPRINT("l" IFMT "", p->n_layer);
     DPRINT("t" IFMT "", p->n_iter);
     DPRINT("mb" IFMT "", p->mb);
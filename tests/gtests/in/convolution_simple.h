@@ -56,6 +56,22 @@ CPU_INST_TEST_CASE(Simple_Blocked8_padded,
     PARAMS(FMT_DATA_BLOCKED, FMT_WEIGHTS_BLOCKED, FMT_BIAS, FMT_DATA_BLOCKED, 2, 1, 23, 13, 13, 19, 13, 13, 1, 1, 0, 0, 1, 1)
 );
 
+CPU_INST_TEST_CASE(Simple_NHWC_Blocked_weights,
+    PARAMS(nhwc, FMT_WEIGHTS_BLOCKED, FMT_BIAS, nhwc,
+        2, 1, 32, 13, 13, 48, 13, 13, 3, 3, 1, 1, 1, 1),
+    PARAMS(nhwc, FMT_WEIGHTS_BLOCKED, FMT_BIAS, nhwc,
+        2, 1, 16, 13, 13, 24, 7, 7, 3, 3, 1, 1, 2, 2),
+    PARAMS(nhwc, FMT_WEIGHTS_BLOCKED_G, FMT_BIAS, nhwc,
+        2, 2, 32, 13, 13, 48, 11, 11, 3, 3, 0, 0, 1, 1),
+    // padded channels
+    PARAMS(nhwc, FMT_WEIGHTS_BLOCKED, FMT_BIAS, nhwc,
+        2, 1, 17, 13, 13, 23, 12, 12, 3, 3, 0, 0, 1, 1),
+    PARAMS(nhwc, FMT_WEIGHTS_BLOCKED, FMT_BIAS, nhwc,
+        2, 1, 21, 13, 13, 16, 13, 13, 3, 3, 1, 1, 1, 1),
+    PARAMS(nhwc, FMT_WEIGHTS_BLOCKED, FMT_BIAS, nhwc,
+        2, 1, 23, 13, 13, 19, 13, 13, 1, 1, 0, 0, 1, 1)
+);
+
 CPU_INST_TEST_CASE(Simple_NCHW,
     PARAMS(nchw, oihw, FMT_BIAS, nchw,
         2, 1, 4, 4, 4, 6, 4, 4, 3, 3, 1, 1, 1, 1),
@@ -14,6 +14,8 @@ INST_TEST_CASE(TestGEMM,
     test_params{'t', 'n', 2, 100, 100, 1.0, 2.0, 100, 100, 100, {}, false},
     test_params{'t', 't', 2, 100, 100, 1.0, 2.0, 100, 100, 100, {}, false},
     test_params{'n', 'n', 2, 2, 10000, 1.0, 2.0, 2, 10000, 2, {}, false},
+    test_params{'n', 'n', 16, 16, 20000, 1.0, 2.0, 16, 20000, 16, {}, false},
+    test_params{'t', 't', 40, 8, 20000, 1.5, 0.5, 20000, 8, 40, {}, false},
 
     make_test_params_with_offset({1, 2, 3}, 'n', 'n', 100, 100, 2, 1.0f, 2.0f, 100, 100, 100),
     make_test_params_with_offset({30, 20, 10}, 'n', 't', 100, 2, 100, 1.0f, 2.0f, 100, 100, 100),
@@ -0,0 +1,192 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <float.h>
+#include <math.h>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+struct attention_test_params {
+    memory::format_tag fmt;
+    memory::dim tq, tk, mb, c, cv;
+    bool with_key_lengths;
+    // the tensors are channel slices of wider ones, as the two directions
+    // of a bidirectional_concat RNN output
+    bool sliced;
+    bool expect_to_fail;
+    mkldnn_status_t expected_status;
+};
+
+template <typename data_t>
+void compute_ref_attention(const attention_test_params &p, float scale,
+        const memory &query, const memory &key, const memory &value,
+        const std::vector<int> &lengths, const memory &dst) {
+    auto q = map_memory<data_t>(query);
+    auto k = map_memory<data_t>(key);
+    auto v = map_memory<data_t>(value);
+    auto d = map_memory<data_t>(dst);
+
+    const memory::desc q_md = query.get_desc(), k_md = key.get_desc(),
+          v_md = value.get_desc(), d_md = dst.get_desc();
+    const mkldnn::impl::memory_desc_wrapper q_d(q_md.data), k_d(k_md.data),
+          v_d(v_md.data), d_d(d_md.data);
+
+    std::vector<float> s(p.tk);
+    for (memory::dim n = 0; n < p.mb; n++)
+    for (memory::dim i = 0; i < p.tq; i++) {
+        const int len = lengths[n];
+        float smax = -FLT_MAX;
+        for (int j = 0; j < len; j++) {
+            float acc = 0.f;
+            for (memory::dim c = 0; c < p.c; c++)
+                acc += q[q_d.off(i, n, c)] * k[k_d.off(j, n, c)];
+            s[j] = scale * acc;
+            smax = std::max(smax, s[j]);
+        }
+        float sum = 0.f;
+        for (int j = 0; j < len; j++) {
+            s[j] = expf(s[j] - smax);
+            sum += s[j];
+        }
+        for (memory::dim c = 0; c < p.cv; c++) {
+            float acc = 0.f;
+            for (int j = 0; j < len; j++)
+                acc += s[j] / sum * v[v_d.off(j, n, c)];
+            d[d_d.off(i, n, c)] = acc;
+        }
+    }
+}
+
+class attention_forward_test
+    : public ::testing::TestWithParam<attention_test_params> {
+    attention_test_params p;
+protected:
+    virtual void SetUp() {
+        p = ::testing::TestWithParam<attention_test_params>::GetParam();
+        catch_expected_failures([=](){Test();}, p.expect_to_fail,
+                    p.expected_status);
+    }
+
+    void Test() {
+        auto eng = engine(get_test_engine_kind(), 0);
+        auto strm = stream(eng);
+        auto dt = memory::data_type::f32;
+
+        // the second half of the channels of a tensor with twice as many,
+        // described by its strides
+        auto md = [&](memory::dim t, memory::dim c) {
+            if (!p.sliced) return memory::desc({t, p.mb, c}, dt, p.fmt);
+            const memory::dim c2 = 2 * c;
+            memory::dims dims = {t, p.mb, c};
+            memory::dims strides = p.fmt == memory::format_tag::tnc
+                ? memory::dims({p.mb * c2, c2, 1})
+                : memory::dims({c2, t * c2, 1});
+            mkldnn_memory_desc_t cmd;
+            mkldnn_memory_desc_init_by_strides(&cmd, 3, &dims[0],
+                    mkldnn_f32, &strides[0]);
+            return memory::desc(cmd);
+        };
+        auto q_md = md(p.tq, p.c);
+        auto k_md = md(p.tk, p.c);
+        auto v_md = md(p.tk, p.cv);
+        auto dst_md = md(p.tq, p.cv);
+        auto kl_md = p.with_key_lengths
+            ? memory::desc({p.mb}, memory::data_type::s32,
+                    memory::format_tag::x)
+            : memory::desc();
+
+        const float scale = p.c > 0 ? 1.f / sqrtf((float)p.c) : 1.f;
+        auto adesc = attention_forward::desc(prop_kind::forward_inference,
+                algorithm::attention_dot_product, q_md, k_md, v_md, kl_md,
+                dst_md, scale);
+        auto apd = attention_forward::primitive_desc(adesc, eng);
+        ASSERT_TRUE(apd.query_desc() == q_md);
+        ASSERT_TRUE(apd.dst_desc() == dst_md);
+
+        // the sliced tensors point into memories of the wide ones
+        auto full_md = [&](memory::dim t, memory::dim c) {
+            return memory::desc({t, p.mb, (p.sliced ? 2 : 1) * c}, dt, p.fmt);
+        };
+        auto q_full = memory(full_md(p.tq, p.c), eng);
+        auto k_full = memory(full_md(p.tk, p.c), eng);
+        auto v_full = memory(full_md(p.tk, p.cv), eng);
+        auto dst_full = memory(full_md(p.tq, p.cv), eng);
+        auto ref_full = memory(full_md(p.tq, p.cv), eng);
+
+        auto slice = [&](const memory::desc &d, const memory &full,
+                memory::dim c) {
+            float *ptr = (float *)full.get_data_handle();
+            return memory(d, eng, ptr + (p.sliced ? c : 0));
+        };
+        auto q = slice(q_md, q_full, p.c);
+        auto k = slice(k_md, k_full, p.c);
+        auto v = slice(v_md, v_full, p.cv);
+        auto dst = slice(dst_md, dst_full, p.cv);
+        auto ref = slice(dst_md, ref_full, p.cv);
+
+        fill_data<float>(q_full.get_desc().get_size() / sizeof(float), q_full,
+                0.f, 1.f);
+        fill_data<float>(k_full.get_desc().get_size() / sizeof(float), k_full,
+                0.5f, 1.f);
+        fill_data<float>(v_full.get_desc().get_size() / sizeof(float), v_full,
+                -0.5f, 1.f);
+
+        std::vector<int> lengths(p.mb, (int)p.tk);
+        std::unordered_map<int, memory> args = {
+            {MKLDNN_ARG_SRC_QUERY, q}, {MKLDNN_ARG_SRC_KEY, k},
+            {MKLDNN_ARG_SRC_VALUE, v}, {MKLDNN_ARG_DST, dst}};
+        if (p.with_key_lengths) {
+            auto kl = memory(kl_md, eng);
+            auto kl_ptr = map_memory<int32_t>(kl);
+            for (memory::dim n = 0; n < p.mb; n++)
+                kl_ptr[n] = lengths[n] = 1 + (int)(n % p.tk);
+            args.insert({MKLDNN_ARG_SRC_KEY_LENGTHS, kl});
+        }
+
+        attention_forward(apd).execute(strm, args);
+        strm.wait();
+
+        compute_ref_attention<float>(p, scale, q, k, v, lengths, ref);
+        compare_data<float>(ref, dst);
+    }
+};
+
+using af = memory::format_tag;
+
+TEST_P(attention_forward_test, TestsAttention) { }
+INSTANTIATE_TEST_SUITE_P(TestAttentionForwardEF, attention_forward_test,
+        ::testing::Values(
+            attention_test_params{af::tnc, 2, 3, 2, 0, 4, false, false,
+            true, mkldnn_invalid_arguments},
+            attention_test_params{af::tnc, 2, 0, 2, 4, 4, false, false,
+            true, mkldnn_invalid_arguments}));
+
+INSTANTIATE_TEST_SUITE_P(TestAttentionForward, attention_forward_test,
+        ::testing::Values(
+            attention_test_params{af::tnc, 1, 7, 3, 16, 16, false, false},
+            attention_test_params{af::tnc, 5, 7, 3, 16, 8, false, false},
+            attention_test_params{af::ntc, 5, 7, 3, 16, 8, false, false},
+            attention_test_params{af::tnc, 5, 9, 4, 12, 20, true, false},
+            attention_test_params{af::ntc, 3, 6, 5, 8, 8, true, false},
+            attention_test_params{af::tnc, 4, 10, 3, 16, 16, true, true},
+            attention_test_params{af::ntc, 1, 10, 2, 32, 32, false, true}));
+
+}
@@ -39,6 +39,10 @@ void compute_ref_conv_bwd_data(const test_convolution_sizes_t &c,
 
     auto padded_ic = diff_src_d.data.padded_dims[1];
     auto padded_oc = diff_dst_d.data.padded_dims[1];
+    /* weights may be padded while the data is not, e.g. for nhwc */
+    const int w_grp = weights_d.data.ndims == 5;
+    auto padded_oc_w = weights_d.data.padded_dims[w_grp];
+    auto padded_ic_w = weights_d.data.padded_dims[w_grp + 1];
 
     const mkldnn::impl::memory_desc_wrapper diff_src_mdw(diff_src_d.data);
     const mkldnn::impl::memory_desc_wrapper weights_mdw(weights_d.data);
@@ -68,9 +72,8 @@ void compute_ref_conv_bwd_data(const test_convolution_sizes_t &c,
                                 + g * padded_oc / c.ng * c.oh * c.ow
                                 + oc * c.oh * c.ow + oh * c.ow + ow;
                             memory::dim widx =
-                                g * padded_oc / c.ng * padded_ic
-                                / c.ng * c.kh * c.kw
-                                + oc * padded_ic / c.ng * c.kh * c.kw
+                                g * padded_oc_w * padded_ic_w * c.kh * c.kw
+                                + oc * padded_ic_w * c.kh * c.kw
                                 + ic * c.kh * c.kw + kh * c.kw + kw;
 
                             a += (data_t_acc)(
@@ -74,12 +74,16 @@ void compute_ref_conv_bwd_weights(const test_convolution_sizes_t &c,
 
     auto padded_ic = src_d.data.padded_dims[1];
     auto padded_oc = dst_d.data.padded_dims[1];
+    /* weights may be padded while the data is not, e.g. for nhwc */
+    const int w_grp = weights_d.data.ndims == 5;
+    auto padded_oc_w = weights_d.data.padded_dims[w_grp];
+    auto padded_ic_w = weights_d.data.padded_dims[w_grp + 1];
 
     mkldnn::impl::parallel_nd(c.ng, c.oc / c.ng, c.ic / c.ng, c.kh, c.kw,
         [&](memory::dim g, memory::dim oc, memory::dim ic, memory::dim kh,
             memory::dim kw) {
-        memory::dim widx = g * padded_oc / c.ng * padded_ic / c.ng * c.kh * c.kw
-                + oc * padded_ic / c.ng * c.kh * c.kw
+        memory::dim widx = g * padded_oc_w * padded_ic_w * c.kh * c.kw
+                + oc * padded_ic_w * c.kh * c.kw
                 + ic * c.kh * c.kw + kh * c.kw + kw;
         diff_weights_data[diff_weights_mdw.off_l(widx, true)] = 0.0;
         for (memory::dim mb = 0; mb < c.mb; ++mb) {
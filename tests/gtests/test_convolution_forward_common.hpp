@@ -49,6 +49,10 @@ void compute_ref_conv_fwd(const test_convolution_sizes_t &c,
 
     auto padded_ic = src_d.data.padded_dims[1];
     auto padded_oc = dst_d.data.padded_dims[1];
+    /* weights may be padded while the data is not, e.g. for nhwc */
+    const int w_grp = weights_d.data.ndims == 5;
+    auto padded_oc_w = weights_d.data.padded_dims[w_grp];
+    auto padded_ic_w = weights_d.data.padded_dims[w_grp + 1];
 
     const mkldnn::impl::memory_desc_wrapper src_mdw(src_d.data);
     const mkldnn::impl::memory_desc_wrapper dst_mdw(dst_d.data);
@@ -71,9 +75,9 @@ void compute_ref_conv_fwd(const test_convolution_sizes_t &c,
                         memory::dim iidx = n * padded_ic * c.ih * c.iw
                             + g * padded_ic / c.ng * c.ih * c.iw
                             + ic * c.ih * c.iw + ih * c.iw + iw;
-                        memory::dim widx = g * padded_oc / c.ng * padded_ic
-                            / c.ng * c.kh * c.kw
-                            + oc * padded_ic / c.ng * c.kh * c.kw
+                        memory::dim widx
+                            = g * padded_oc_w * padded_ic_w * c.kh * c.kw
+                            + oc * padded_ic_w * c.kh * c.kw
                             + ic * c.kh * c.kw + kh * c.kw + kw;
                         a += ((data_t_acc)
                             src_data[src_mdw.off_l(iidx, true)])